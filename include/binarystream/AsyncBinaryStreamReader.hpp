@@ -0,0 +1,207 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <binarystream/ReadOnlyBinaryStream.hpp>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace bstream {
+
+// Lazily started coroutine. Awaiting it from another coroutine starts it and resumes the awaiter when it finishes;
+// plain code can drive it with start() and check done().
+template <typename T>
+class AsyncTask {
+public:
+    struct promise_type {
+        std::optional<T>        mValue;
+        std::coroutine_handle<> mContinuation;
+
+        AsyncTask get_return_object() noexcept {
+            return AsyncTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        auto final_suspend() noexcept {
+            struct FinalAwaiter {
+                bool await_ready() noexcept { return false; }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                    auto continuation = handle.promise().mContinuation;
+                    return continuation ? continuation : std::noop_coroutine();
+                }
+                void await_resume() noexcept {}
+            };
+            return FinalAwaiter{};
+        }
+
+        void return_value(T value) { mValue = std::move(value); }
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+
+private:
+    std::coroutine_handle<promise_type> mHandle;
+
+    explicit AsyncTask(std::coroutine_handle<promise_type> handle) noexcept : mHandle(handle) {}
+
+public:
+    AsyncTask(AsyncTask&& other) noexcept : mHandle(std::exchange(other.mHandle, {})) {}
+    AsyncTask(AsyncTask const&)            = delete;
+    AsyncTask& operator=(AsyncTask const&) = delete;
+    AsyncTask& operator=(AsyncTask&&)      = delete;
+
+    ~AsyncTask() {
+        if (mHandle) { mHandle.destroy(); }
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) noexcept {
+        mHandle.promise().mContinuation = awaiter;
+        return mHandle;
+    }
+
+    T await_resume() { return std::move(*mHandle.promise().mValue); }
+
+    void start() { mHandle.resume(); }
+
+    [[nodiscard]] bool done() const noexcept { return mHandle.done(); }
+
+    [[nodiscard]] T& result() { return *mHandle.promise().mValue; }
+};
+
+// Result of an AsyncBinaryStreamReader read: either a value decoded from bytes that were already buffered, which is
+// ready without allocating or suspending, or a task that waits for more bytes. Awaited or driven like AsyncTask.
+template <typename T>
+class AsyncRead {
+    std::optional<T>            mValue;
+    std::optional<AsyncTask<T>> mTask;
+
+public:
+    AsyncRead(T value) : mValue(std::move(value)) {}
+    AsyncRead(AsyncTask<T> task) : mTask(std::move(task)) {}
+
+    bool await_ready() const noexcept { return mValue.has_value(); }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) noexcept {
+        return mTask->await_suspend(awaiter);
+    }
+
+    T await_resume() { return mValue ? std::move(*mValue) : mTask->await_resume(); }
+
+    void start() {
+        if (mTask) { mTask->start(); }
+    }
+
+    [[nodiscard]] bool done() const noexcept { return mValue || mTask->done(); }
+
+    [[nodiscard]] T& result() { return mValue ? *mValue : mTask->result(); }
+};
+
+// Non-blocking byte producer for AsyncBinaryStreamReader
+class AsyncByteSource {
+public:
+    virtual ~AsyncByteSource() = default;
+
+    // Copies up to capacity already available bytes into buffer; returns 0 if none are available right now
+    virtual size_t readSome(char* buffer, size_t capacity) = 0;
+
+    // True once no further bytes will become available
+    [[nodiscard]] virtual bool isClosed() const = 0;
+
+    // Returns false if bytes or end of stream are already available. Otherwise keeps the waiter and resumes it once
+    // either happens, returning true.
+    virtual bool waitReadable(std::coroutine_handle<> waiter) = 0;
+};
+
+// In-memory source fed by push(); the waiting reader is resumed inline, so producer and reader share one thread
+class PipeByteSource : public AsyncByteSource {
+    std::string             mPending;
+    size_t                  mOffset;
+    bool                    mClosed;
+    std::coroutine_handle<> mWaiter;
+
+public:
+    [[nodiscard]] BSAPI PipeByteSource();
+
+    BSAPI void push(std::string_view data);
+    BSAPI void close();
+
+    BSAPI size_t             readSome(char* buffer, size_t capacity) override;
+    [[nodiscard]] BSAPI bool isClosed() const override;
+    BSAPI bool               waitReadable(std::coroutine_handle<> waiter) override;
+};
+
+// Decodes the ReadOnlyBinaryStream wire format from an AsyncByteSource. Values whose bytes the source already has are
+// decoded on the spot and returned as ready AsyncReads; a coroutine is only started when the reader has to wait.
+// Running past the end of a closed source, or a string or raw byte length above getMaxLength(), sets the overflow
+// flag, after which every read returns a zero value.
+class AsyncBinaryStreamReader {
+    AsyncByteSource& mSource;
+    std::string      mBuffer;
+    size_t           mPosition;
+    size_t           mMaxLength;
+    bool             mHasOverflowed;
+    const bool       mBigEndian;
+
+    [[nodiscard]] size_t buffered() const noexcept;
+
+    bool            pull();
+    bool            available(size_t size);
+    AsyncTask<bool> fill(size_t size);
+    void            take(void* target, size_t size) noexcept;
+
+    template <typename T>
+    T takeFixed() noexcept;
+    template <typename T>
+    bool tryVarInt(T& value);
+    bool tryRawBytes(std::string& result, size_t length);
+
+    template <typename T>
+    AsyncRead<T> readFixed();
+    template <typename T>
+    AsyncTask<T> waitFixed();
+    template <typename T>
+    AsyncTask<T> waitVarInt();
+    AsyncTask<bool>        waitBytes(void* target, size_t size);
+    AsyncTask<std::string> waitString();
+    AsyncTask<std::string> waitRawBytes(size_t length);
+
+public:
+    static constexpr size_t DefaultMaxLength = 16 * 1024 * 1024;
+
+    [[nodiscard]] BSAPI explicit AsyncBinaryStreamReader(AsyncByteSource& source, bool bigEndian = false);
+
+    [[nodiscard]] BSAPI bool isOverflowed() const noexcept;
+
+    // Upper bound on the length prefix of readString and the length of readRawBytes, so that a corrupt or hostile
+    // length cannot make the reader buffer without limit
+    [[nodiscard]] BSAPI size_t getMaxLength() const noexcept;
+    BSAPI void                 setMaxLength(size_t value) noexcept;
+
+    BSAPI AsyncRead<bool>        readBytes(void* target, size_t size);
+    BSAPI AsyncRead<uint8_t>     readUnsignedChar();
+    BSAPI AsyncRead<bool>        readBool();
+    BSAPI AsyncRead<uint16_t>    readUnsignedShort();
+    BSAPI AsyncRead<int16_t>     readSignedShort();
+    BSAPI AsyncRead<uint32_t>    readUnsignedInt();
+    BSAPI AsyncRead<int32_t>     readSignedInt();
+    BSAPI AsyncRead<uint64_t>    readUnsignedInt64();
+    BSAPI AsyncRead<int64_t>     readSignedInt64();
+    BSAPI AsyncRead<float>       readFloat();
+    BSAPI AsyncRead<double>      readDouble();
+    BSAPI AsyncRead<uint32_t>    readUnsignedVarInt();
+    BSAPI AsyncRead<uint64_t>    readUnsignedVarInt64();
+    BSAPI AsyncRead<int32_t>     readVarInt();
+    BSAPI AsyncRead<int64_t>     readVarInt64();
+    BSAPI AsyncRead<std::string> readString();
+    BSAPI AsyncRead<std::string> readRawBytes(size_t length);
+};
+
+} // namespace bstream
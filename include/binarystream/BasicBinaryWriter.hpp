@@ -0,0 +1,242 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <binarystream/ReadOnlyBinaryStream.hpp>
+#include <binarystream/detail/VarInt.hpp>
+
+namespace bstream {
+
+namespace detail {
+// Where the out-of-line bulk encoders put their bytes. An encoder stages its output in a fixed-size chunk on its own
+// stack and hands the sink one chunk at a time, so encoding never allocates on behalf of the writer it serves.
+class ByteSink {
+    using AppendFunction  = void (*)(void* target, const char* data, size_t size);
+    using ReserveFunction = void (*)(void* target, size_t size);
+
+    void*           mTarget;
+    AppendFunction  mAppend;
+    ReserveFunction mReserve;
+
+public:
+    [[nodiscard]] ByteSink(void* target, AppendFunction append, ReserveFunction reserve = nullptr) noexcept
+    : mTarget(target),
+      mAppend(append),
+      mReserve(reserve) {}
+
+    [[nodiscard]] explicit ByteSink(std::string& out) noexcept
+    : ByteSink(
+          &out,
+          [](void* target, const char* data, size_t size) { static_cast<std::string*>(target)->append(data, size); },
+          [](void* target, size_t size) {
+              auto& buffer = *static_cast<std::string*>(target);
+              buffer.reserve(buffer.size() + size);
+          }
+      ) {}
+
+    void append(const void* data, size_t size) const { mAppend(mTarget, static_cast<const char*>(data), size); }
+
+    // Hints that up to size more bytes will be appended
+    void reserve(size_t size) const {
+        if (mReserve) { mReserve(mTarget, size); }
+    }
+};
+
+// Bulk encoders shared by BinaryStream and BasicBinaryWriter
+BSAPI bool appendPackedBitArray(
+    ByteSink                  out,
+    std::span<const uint16_t> entries,
+    uint8_t                   bitsPerEntry,
+    bool                      bigEndian
+);
+BSAPI void appendDeltaVarInts(ByteSink out, std::span<const int32_t> values);
+BSAPI void appendDeltaVarInt64s(ByteSink out, std::span<const int64_t> values);
+BSAPI void appendFrameOfReference(ByteSink out, std::span<const uint32_t> values);
+BSAPI void appendXorFloats(ByteSink out, std::span<const float> values);
+BSAPI void appendXorDoubles(ByteSink out, std::span<const double> values);
+BSAPI void appendNormalizedFloats(ByteSink out, std::span<const float> values, bool bigEndian);
+BSAPI void appendHalfFloats(ByteSink out, std::span<const float> values, bool bigEndian);
+BSAPI bool appendFixed16Floats(ByteSink out, std::span<const float> values, uint8_t fractionalBits, bool bigEndian);
+BSAPI bool appendFixed32Floats(ByteSink out, std::span<const float> values, uint8_t fractionalBits, bool bigEndian);
+BSAPI void appendPrefixVarInts(ByteSink out, std::span<const uint64_t> values);
+BSAPI void appendGroupVarInts(ByteSink out, std::span<const uint32_t> values);
+} // namespace detail
+
+// The BinaryStream write API over an arbitrary byte sink. BinaryStream forwards its writers here, so both produce the
+// same bytes.
+// Derived provides appendBytes(const char*, size_t) and isBigEndian() const. Every writer except writeBytes and
+// writeStream is constexpr when Derived's hooks are.
+template <typename Derived>
+class BasicBinaryWriter {
+    constexpr Derived& self() noexcept { return static_cast<Derived&>(*this); }
+
+    template <typename T>
+    constexpr void write(T value, bool bigEndian) {
+        if (bigEndian) { value = detail::swapEndian(value); }
+        auto bytes = std::bit_cast<std::array<char, sizeof(T)>>(value);
+        self().appendBytes(bytes.data(), sizeof(T));
+    }
+
+    constexpr void writeVarIntBytes(uint64_t uvalue) {
+        char bytes[detail::MaxVarInt64Length]{};
+        self().appendBytes(bytes, detail::encodeVarInt(uvalue, bytes));
+    }
+
+    // Lets the out-of-line bulk encoders append straight to Derived
+    detail::ByteSink sink() noexcept {
+        return detail::ByteSink(&self(), [](void* target, const char* data, size_t size) {
+            static_cast<Derived*>(target)->appendBytes(data, size);
+        });
+    }
+
+public:
+    void writeBytes(const void* origin, size_t num) {
+        if (num > 0) { self().appendBytes(static_cast<const char*>(origin), num); }
+    }
+
+    constexpr void writeByte(std::byte value) { write(value, self().isBigEndian()); }
+
+    constexpr void writeUnsignedChar(uint8_t value) { write(value, self().isBigEndian()); }
+
+    constexpr void writeUnsignedShort(uint16_t value) { write(value, self().isBigEndian()); }
+
+    constexpr void writeUnsignedInt(uint32_t value) { write(value, self().isBigEndian()); }
+
+    constexpr void writeUnsignedInt64(uint64_t value) { write(value, self().isBigEndian()); }
+
+    constexpr void writeBool(bool value) { write(value, self().isBigEndian()); }
+
+    constexpr void writeDouble(double value) { write(value, self().isBigEndian()); }
+
+    constexpr void writeFloat(float value) { write(value, self().isBigEndian()); }
+
+    constexpr void writeSignedInt(int32_t value) { write(value, self().isBigEndian()); }
+
+    constexpr void writeSignedInt64(int64_t value) { write(value, self().isBigEndian()); }
+
+    constexpr void writeSignedShort(int16_t value) { write(value, self().isBigEndian()); }
+
+    constexpr void writeUnsignedVarInt(uint32_t uvalue) {
+        if (self().isBigEndian()) { uvalue = detail::swapEndian(uvalue); }
+        writeVarIntBytes(uvalue);
+    }
+
+    constexpr void writeUnsignedVarInt64(uint64_t uvalue) {
+        if (self().isBigEndian()) { uvalue = detail::swapEndian(uvalue); }
+        writeVarIntBytes(uvalue);
+    }
+
+    constexpr void writeVarInt(int32_t value) {
+        if (value >= 0) {
+            writeUnsignedVarInt(static_cast<uint32_t>(value) << 1);
+        } else {
+            writeUnsignedVarInt((static_cast<uint32_t>(~value) << 1) | 1);
+        }
+    }
+
+    constexpr void writeVarInt64(int64_t value) {
+        if (value >= 0) {
+            writeUnsignedVarInt64(static_cast<uint64_t>(value) << 1);
+        } else {
+            writeUnsignedVarInt64((static_cast<uint64_t>(~value) << 1) | 1);
+        }
+    }
+
+    constexpr void writeNormalizedFloat(float value) { writeVarInt64(static_cast<int64_t>(value * 2147483647.0f)); }
+
+    constexpr void writeSignedBigEndianInt(int32_t value) { write(value, true); }
+
+    constexpr void writeString(std::string_view value) {
+        auto size = static_cast<uint32_t>(value.size());
+        writeUnsignedVarInt(size);
+        writeRawBytes(value, static_cast<size_t>(size));
+    }
+
+    constexpr void writeShortString(std::string_view value) {
+        auto size = static_cast<int16_t>(value.size());
+        writeSignedShort(size);
+        writeRawBytes(value, static_cast<size_t>(size));
+    }
+
+    constexpr void writeLongString(std::string_view value) {
+        auto size = static_cast<int>(value.size());
+        writeSignedInt(size);
+        writeRawBytes(value, static_cast<size_t>(size));
+    }
+
+    constexpr void writeUnsignedInt24(uint32_t value) {
+        if (self().isBigEndian()) {
+            writeUnsignedChar(static_cast<uint8_t>((value >> 16) & 0xFF));
+            writeUnsignedChar(static_cast<uint8_t>((value >> 8) & 0xFF));
+            writeUnsignedChar(static_cast<uint8_t>(value & 0xFF));
+        } else {
+            writeUnsignedChar(static_cast<uint8_t>(value & 0xFF));
+            writeUnsignedChar(static_cast<uint8_t>((value >> 8) & 0xFF));
+            writeUnsignedChar(static_cast<uint8_t>((value >> 16) & 0xFF));
+        }
+    }
+
+    constexpr void writeRawBytes(std::string_view rawBuffer) {
+        if (!rawBuffer.empty()) { self().appendBytes(rawBuffer.data(), rawBuffer.size()); }
+    }
+
+    constexpr void writeRawBytes(std::string_view rawBuffer, size_t size) {
+        if (!rawBuffer.empty()) { self().appendBytes(rawBuffer.data(), size); }
+    }
+
+    void writeStream(ReadOnlyBinaryStream const& stream) { writeRawBytes(stream.view()); }
+
+    template <detail::BulkArithmetic T>
+    constexpr void writeArray(std::span<const T> values) {
+        if !consteval {
+            if (!self().isBigEndian()) {
+                writeBytes(values.data(), values.size_bytes());
+                return;
+            }
+        }
+        for (T value : values) { write(value, self().isBigEndian()); }
+    }
+
+    // Same bytes as the BinaryStream bulk writers of the same name; not constexpr
+    bool writePackedBitArray(std::span<const uint16_t> entries, uint8_t bitsPerEntry) {
+        return detail::appendPackedBitArray(sink(), entries, bitsPerEntry, self().isBigEndian());
+    }
+
+    void writeDeltaVarInts(std::span<const int32_t> values) { detail::appendDeltaVarInts(sink(), values); }
+
+    void writeDeltaVarInt64s(std::span<const int64_t> values) { detail::appendDeltaVarInt64s(sink(), values); }
+
+    void writeFrameOfReference(std::span<const uint32_t> values) { detail::appendFrameOfReference(sink(), values); }
+
+    void writeXorFloats(std::span<const float> values) { detail::appendXorFloats(sink(), values); }
+
+    void writeXorDoubles(std::span<const double> values) { detail::appendXorDoubles(sink(), values); }
+
+    void writeNormalizedFloats(std::span<const float> values) {
+        detail::appendNormalizedFloats(sink(), values, self().isBigEndian());
+    }
+
+    void writeHalfFloats(std::span<const float> values) {
+        detail::appendHalfFloats(sink(), values, self().isBigEndian());
+    }
+
+    bool writeFixed16Floats(std::span<const float> values, uint8_t fractionalBits) {
+        return detail::appendFixed16Floats(sink(), values, fractionalBits, self().isBigEndian());
+    }
+
+    bool writeFixed32Floats(std::span<const float> values, uint8_t fractionalBits) {
+        return detail::appendFixed32Floats(sink(), values, fractionalBits, self().isBigEndian());
+    }
+
+    void writePrefixVarInt(uint64_t value) { writePrefixVarInts(std::span<const uint64_t>(&value, 1)); }
+
+    void writePrefixVarInts(std::span<const uint64_t> values) { detail::appendPrefixVarInts(sink(), values); }
+
+    void writeGroupVarInts(std::span<const uint32_t> values) { detail::appendGroupVarInts(sink(), values); }
+};
+
+} // namespace bstream
@@ -0,0 +1,267 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <binarystream/ReadOnlyBinaryStream.hpp>
+#include <binarystream/detail/VarInt.hpp>
+#include <cstring>
+
+namespace bstream {
+
+// A trivially copyable reader over borrowed memory with the ReadOnlyBinaryStream decoding API, meant to be passed by
+// value through hot decode functions. Scalar reads are inline; bulk reads share ReadOnlyBinaryStream's decoders.
+// Unlike ReadOnlyBinaryStream it never moves past the end of the buffer: skipping or reading too far marks it
+// overflowed, and strings are not checked for UTF-8.
+class BinaryReader {
+    const char* mBegin;
+    const char* mCursor;
+    const char* mEnd;
+    bool        mHasOverflowed;
+    bool        mBigEndian;
+
+    [[nodiscard]] size_t remaining() const noexcept { return static_cast<size_t>(mEnd - mCursor); }
+
+    template <typename T>
+    T read(bool bigEndian) noexcept {
+        if (mHasOverflowed || sizeof(T) > remaining()) {
+            mHasOverflowed = true;
+            return T{};
+        }
+        T value  = detail::loadFixed<T>(mCursor, bigEndian);
+        mCursor += sizeof(T);
+        return value;
+    }
+
+    template <typename T>
+    T readVarInt() noexcept {
+        auto begin  = reinterpret_cast<const uint8_t*>(mCursor);
+        auto cursor = begin;
+        T    value  = 0;
+        bool valid  = detail::decodeVarInt(cursor, begin + remaining(), value);
+        mCursor   += cursor - begin;
+        if (!valid) {
+            mHasOverflowed = true;
+            return value;
+        }
+        return mBigEndian ? detail::swapEndian(value) : value;
+    }
+
+    // Runs a shared bulk decoder over the remaining bytes and moves past what it used, or marks the reader overflowed
+    template <typename Decode>
+    bool decodeRemaining(Decode&& decode) {
+        if (mHasOverflowed) { return false; }
+        size_t consumed = 0;
+        if (!decode(std::string_view(mCursor, remaining()), consumed)) {
+            mHasOverflowed = true;
+            return false;
+        }
+        mCursor += consumed;
+        return true;
+    }
+
+    std::string_view readView(size_t length) noexcept {
+        if (mHasOverflowed || length > remaining()) {
+            mHasOverflowed = true;
+            return {};
+        }
+        std::string_view result(mCursor, length);
+        mCursor += length;
+        return result;
+    }
+
+public:
+    [[nodiscard]] BinaryReader() noexcept : BinaryReader(std::string_view()) {}
+
+    [[nodiscard]] explicit BinaryReader(std::string_view buffer, bool bigEndian = false) noexcept
+    : mBegin(buffer.data()),
+      mCursor(buffer.data()),
+      mEnd(buffer.data() + buffer.size()),
+      mHasOverflowed(false),
+      mBigEndian(bigEndian) {}
+
+    // Borrows the stream's bytes and continues from its position
+    [[nodiscard]] explicit BinaryReader(ReadOnlyBinaryStream const& stream) noexcept
+    : BinaryReader(stream.mBufferView, stream.mBigEndian) {
+        mHasOverflowed = stream.mHasOverflowed;
+        setPosition(stream.mReadPointer);
+    }
+
+    // A borrowing stream with this reader's position and overflow state
+    [[nodiscard]] ReadOnlyBinaryStream toStream() const {
+        ReadOnlyBinaryStream result(view(), false, mBigEndian);
+        syncTo(result);
+        return result;
+    }
+
+    // Writes the position and overflow state back into the stream this reader was created from
+    void syncTo(ReadOnlyBinaryStream& stream) const noexcept {
+        stream.mReadPointer   = getPosition();
+        stream.mHasOverflowed = mHasOverflowed;
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return static_cast<size_t>(mEnd - mBegin); }
+    [[nodiscard]] size_t getPosition() const noexcept { return static_cast<size_t>(mCursor - mBegin); }
+
+    void setPosition(size_t value) noexcept {
+        if (value > size()) {
+            mHasOverflowed = true;
+            value          = size();
+        }
+        mCursor = mBegin + value;
+    }
+    void resetPosition() noexcept { mCursor = mBegin; }
+    void ignoreBytes(size_t length) noexcept { static_cast<void>(readView(length)); }
+
+    [[nodiscard]] bool             isOverflowed() const noexcept { return mHasOverflowed; }
+    [[nodiscard]] bool             hasDataLeft() const noexcept { return mCursor < mEnd; }
+    [[nodiscard]] std::string_view view() const noexcept { return std::string_view(mBegin, size()); }
+
+    bool getBytes(void* target, size_t num) noexcept {
+        if (mHasOverflowed) { return false; }
+        if (num == 0) { return true; }
+        auto bytes = readView(num);
+        if (bytes.empty()) { return false; }
+        std::memcpy(target, bytes.data(), num);
+        return true;
+    }
+
+    [[nodiscard]] std::byte getByte() noexcept { return std::byte(getUnsignedChar()); }
+    [[nodiscard]] uint8_t   getUnsignedChar() noexcept { return read<uint8_t>(mBigEndian); }
+    [[nodiscard]] uint16_t  getUnsignedShort() noexcept { return read<uint16_t>(mBigEndian); }
+    [[nodiscard]] uint32_t  getUnsignedInt() noexcept { return read<uint32_t>(mBigEndian); }
+    [[nodiscard]] uint64_t  getUnsignedInt64() noexcept { return read<uint64_t>(mBigEndian); }
+    [[nodiscard]] bool      getBool() noexcept { return getUnsignedChar() != 0; }
+    [[nodiscard]] double    getDouble() noexcept { return read<double>(mBigEndian); }
+    [[nodiscard]] float     getFloat() noexcept { return read<float>(mBigEndian); }
+    [[nodiscard]] int32_t   getSignedInt() noexcept { return read<int32_t>(mBigEndian); }
+    [[nodiscard]] int64_t   getSignedInt64() noexcept { return read<int64_t>(mBigEndian); }
+    [[nodiscard]] int16_t   getSignedShort() noexcept { return read<int16_t>(mBigEndian); }
+    [[nodiscard]] uint32_t  getUnsignedVarInt() noexcept { return readVarInt<uint32_t>(); }
+    [[nodiscard]] uint64_t  getUnsignedVarInt64() noexcept { return readVarInt<uint64_t>(); }
+    [[nodiscard]] int32_t   getSignedBigEndianInt() noexcept { return read<int32_t>(true); }
+
+    [[nodiscard]] int32_t getVarInt() noexcept { return detail::zigzagDecode(getUnsignedVarInt()); }
+    [[nodiscard]] int64_t getVarInt64() noexcept { return detail::zigzagDecode(getUnsignedVarInt64()); }
+
+    [[nodiscard]] float getNormalizedFloat() noexcept { return static_cast<float>(getVarInt64()) / 2147483647.0f; }
+
+    [[nodiscard]] uint32_t getUnsignedInt24() noexcept {
+        auto bytes = readView(3);
+        if (bytes.empty()) { return 0; }
+        auto byte = [&bytes](size_t index) { return static_cast<uint32_t>(static_cast<uint8_t>(bytes[index])); };
+        return mBigEndian ? (byte(0) << 16) | (byte(1) << 8) | byte(2) : byte(0) | (byte(1) << 8) | (byte(2) << 16);
+    }
+
+    [[nodiscard]] std::string_view getStringView() noexcept { return readView(getUnsignedVarInt()); }
+    [[nodiscard]] std::string_view getShortStringView() noexcept {
+        return readView(static_cast<size_t>(getSignedShort()));
+    }
+    [[nodiscard]] std::string_view getLongStringView() noexcept {
+        return readView(static_cast<size_t>(getSignedInt()));
+    }
+
+    void getString(std::string& outString) { outString.assign(getStringView()); }
+    void getShortString(std::string& outString) { outString.assign(getShortStringView()); }
+    void getLongString(std::string& outString) { outString.assign(getLongStringView()); }
+
+    [[nodiscard]] std::string getString() { return std::string(getStringView()); }
+    [[nodiscard]] std::string getShortString() { return std::string(getShortStringView()); }
+    [[nodiscard]] std::string getLongString() { return std::string(getLongStringView()); }
+
+    void getRawBytes(std::string& rawBuffer, size_t length) { rawBuffer.assign(readView(length)); }
+    [[nodiscard]] std::string getRawBytes(size_t length) { return std::string(readView(length)); }
+
+    template <detail::BulkArithmetic T>
+    bool getArray(std::span<T> values) noexcept {
+        if (!getBytes(values.data(), values.size_bytes())) { return false; }
+        if (mBigEndian) { detail::swapEndianArray(values.data(), values.size(), sizeof(T)); }
+        return true;
+    }
+
+    // Bulk decoders with the same bytes and results as the ReadOnlyBinaryStream methods of the same name
+    bool getPackedBitArray(std::span<uint16_t> entries, uint8_t bitsPerEntry) {
+        return decodeRemaining([&](std::string_view unread, size_t& consumed) {
+            return detail::decodePackedBitArray(unread, consumed, entries, bitsPerEntry, mBigEndian);
+        });
+    }
+
+    bool getDeltaVarInts(std::span<int32_t> values) {
+        return decodeRemaining([values](std::string_view unread, size_t& consumed) {
+            return detail::decodeDeltaVarInts(unread, consumed, values);
+        });
+    }
+
+    bool getDeltaVarInt64s(std::span<int64_t> values) {
+        return decodeRemaining([values](std::string_view unread, size_t& consumed) {
+            return detail::decodeDeltaVarInt64s(unread, consumed, values);
+        });
+    }
+
+    bool getFrameOfReference(std::span<uint32_t> values) {
+        return decodeRemaining([values](std::string_view unread, size_t& consumed) {
+            return detail::decodeFrameOfReference(unread, consumed, values);
+        });
+    }
+
+    bool getXorFloats(std::span<float> values) {
+        return decodeRemaining([values](std::string_view unread, size_t& consumed) {
+            return detail::decodeXorFloats(unread, consumed, values);
+        });
+    }
+
+    bool getXorDoubles(std::span<double> values) {
+        return decodeRemaining([values](std::string_view unread, size_t& consumed) {
+            return detail::decodeXorDoubles(unread, consumed, values);
+        });
+    }
+
+    bool getNormalizedFloats(std::span<float> values) {
+        return decodeRemaining([&](std::string_view unread, size_t& consumed) {
+            return detail::decodeNormalizedFloats(unread, consumed, values, mBigEndian);
+        });
+    }
+
+    bool getHalfFloats(std::span<float> values) {
+        return decodeRemaining([&](std::string_view unread, size_t& consumed) {
+            return detail::decodeHalfFloats(unread, consumed, values, mBigEndian);
+        });
+    }
+
+    bool getFixed16Floats(std::span<float> values, uint8_t fractionalBits) {
+        return decodeRemaining([&](std::string_view unread, size_t& consumed) {
+            return detail::decodeFixed16Floats(unread, consumed, values, fractionalBits, mBigEndian);
+        });
+    }
+
+    bool getFixed32Floats(std::span<float> values, uint8_t fractionalBits) {
+        return decodeRemaining([&](std::string_view unread, size_t& consumed) {
+            return detail::decodeFixed32Floats(unread, consumed, values, fractionalBits, mBigEndian);
+        });
+    }
+
+    [[nodiscard]] uint64_t getPrefixVarInt() noexcept {
+        uint64_t value = 0;
+        if (!getPrefixVarInts(std::span<uint64_t>(&value, 1))) { return 0; }
+        return value;
+    }
+
+    bool getPrefixVarInts(std::span<uint64_t> values) noexcept {
+        return decodeRemaining([values](std::string_view unread, size_t& consumed) noexcept {
+            return detail::decodePrefixVarInts(unread, consumed, values);
+        });
+    }
+
+    bool getGroupVarInts(std::span<uint32_t> values) noexcept {
+        return decodeRemaining([values](std::string_view unread, size_t& consumed) noexcept {
+            return detail::decodeGroupVarInts(unread, consumed, values);
+        });
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<BinaryReader>);
+
+} // namespace bstream
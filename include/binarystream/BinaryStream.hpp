@@ -15,21 +15,26 @@ protected:
     std::string& mBuffer;
 
 private:
-    template <typename T>
-    void write(T value, bool bigEndian = false);
+    class Writer;
 
 public:
     [[nodiscard]] BSAPI explicit BinaryStream(bool bigEndian = false);
     [[nodiscard]] BSAPI explicit BinaryStream(std::string& buffer, bool copyBuffer = false, bool bigEndian = false);
 
+    // A copy of a stream that owns its buffer owns a copy of the bytes; a copy of a stream writing into an external
+    // string writes into the same string
+    [[nodiscard]] BSAPI BinaryStream(BinaryStream const& other);
+    [[nodiscard]] BSAPI BinaryStream(BinaryStream&& other) noexcept;
+
     BSAPI void reserve(size_t size);
     BSAPI void reset() noexcept;
 
     [[nodiscard]] BSAPI std::string& data() noexcept;
     [[nodiscard]] BSAPI const std::string& data() const noexcept;
 
-    [[nodiscard]] BSAPI std::string copyBuffer() const;
-    [[nodiscard]] BSAPI std::string getAndReleaseData();
+    [[nodiscard]] BSAPI std::string  copyBuffer() const;
+    [[nodiscard]] BSAPI std::string  getAndReleaseData();
+    [[nodiscard]] BSAPI SharedBuffer getAndReleaseSharedBuffer();
 
     BSAPI void writeBytes(const void* origin, size_t num);
     BSAPI void writeByte(std::byte value);
@@ -56,6 +61,45 @@ public:
     BSAPI void writeRawBytes(std::string_view rawBuffer);
     BSAPI void writeRawBytes(std::string_view rawBuffer, size_t size);
     BSAPI void writeStream(ReadOnlyBinaryStream const& stream);
+
+    // Same bytes as writing each element with the matching fixed-width writer
+    template <detail::BulkArithmetic T>
+    void writeArray(std::span<const T> values) {
+        size_t offset = mBuffer.size();
+        writeBytes(values.data(), values.size_bytes());
+        if (mBigEndian) { detail::swapEndianArray(mBuffer.data() + offset, values.size(), sizeof(T)); }
+    }
+
+    BSAPI bool writePackedBitArray(std::span<const uint16_t> entries, uint8_t bitsPerEntry);
+
+    // Sequence encoders; the element count is not written, so the reader must already know it
+    // Delta + zigzag varints, the first element relative to zero
+    BSAPI void writeDeltaVarInts(std::span<const int32_t> values);
+    BSAPI void writeDeltaVarInt64s(std::span<const int64_t> values);
+    // Minimum as a varint, bit width as a byte, then (value - minimum) bit-packed lowest bits first
+    BSAPI void writeFrameOfReference(std::span<const uint32_t> values);
+    // Bit pattern XORed with the previous element's (the first with zero), Gorilla-style: two bits for a repeat,
+    // otherwise the bits after the leading zeros, or only those between the leading and trailing zeros when there are
+    // enough trailing zeros, with the leading-zero count rounded to one of eight classes and reused when unchanged
+    BSAPI void writeXorFloats(std::span<const float> values);
+    BSAPI void writeXorDoubles(std::span<const double> values);
+
+    // Bulk float encoders
+    // Same encoding as repeated writeNormalizedFloat calls
+    BSAPI void writeNormalizedFloats(std::span<const float> values);
+    // IEEE 754 half precision, converted with F16C or NEON when available
+    BSAPI void writeHalfFloats(std::span<const float> values);
+    // Signed fixed point with the given number of fractional bits, rounded to nearest and saturated; returns false
+    // and writes nothing unless fractionalBits is below the integer's bit width
+    BSAPI bool writeFixed16Floats(std::span<const float> values, uint8_t fractionalBits);
+    BSAPI bool writeFixed32Floats(std::span<const float> values, uint8_t fractionalBits);
+
+    // Loop-free alternatives to LEB128 varints, always little-endian
+    // PrefixVarint: the first byte's trailing zero count gives the length, at most 9 bytes
+    BSAPI void writePrefixVarInt(uint64_t value);
+    BSAPI void writePrefixVarInts(std::span<const uint64_t> values);
+    // Groups of four values behind one control byte of two-bit lengths; the count is not written
+    BSAPI void writeGroupVarInts(std::span<const uint32_t> values);
 };
 
 } // namespace bstream
\ No newline at end of file
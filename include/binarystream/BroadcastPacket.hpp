@@ -0,0 +1,107 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <binarystream/BinaryStream.hpp>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace bstream {
+
+// One recipient's version of a BroadcastPacket: the shared payload plus that recipient's field values, kept apart so
+// the payload is never copied. segments() yields the bytes in order for scatter/gather sends; appendTo() and
+// toStream() assemble them when a contiguous copy is needed.
+class PatchedPacket {
+    friend class BroadcastPacket;
+
+    struct Patch {
+        size_t mOffset;
+        size_t mSize;
+    };
+
+    SharedBuffer       mBuffer;
+    std::vector<Patch> mPatches;
+    std::string        mValues;
+    bool               mBigEndian;
+
+    PatchedPacket(SharedBuffer buffer, bool bigEndian);
+
+public:
+    [[nodiscard]] BSAPI size_t              size() const noexcept;
+    [[nodiscard]] BSAPI SharedBuffer const& buffer() const noexcept;
+
+    // Alternating runs of the shared payload and patched values, in packet order, skipping empty runs
+    [[nodiscard]] BSAPI std::vector<std::string_view> segments() const;
+
+    BSAPI void                               appendTo(std::string& out) const;
+    [[nodiscard]] BSAPI ReadOnlyBinaryStream toStream() const;
+};
+
+// A packet serialized once for many recipients. Recipients that see identical bytes share the buffer through view();
+// fixed-width fields registered with addField can be overwritten per recipient with patched(), which shares the
+// buffer too and only stores the recipient's field values.
+class BroadcastPacket {
+    struct Field {
+        size_t mOffset;
+        size_t mSize;
+    };
+
+    SharedBuffer        mBuffer;
+    std::vector<Field>  mFields;
+    std::vector<size_t> mOrder;
+    bool                mBigEndian;
+
+public:
+    [[nodiscard]] BSAPI explicit BroadcastPacket(SharedBuffer buffer, bool bigEndian = false);
+
+    // Registers the next patchable field; fails if the range is outside the packet or overlaps another field
+    BSAPI bool addField(size_t offset, size_t size);
+
+    [[nodiscard]] BSAPI size_t              fieldCount() const noexcept;
+    [[nodiscard]] BSAPI SharedBuffer const& buffer() const noexcept;
+
+    [[nodiscard]] BSAPI ReadOnlyBinaryStream view() const;
+
+    // One raw value per registered field, in registration order. Returns nullopt if the count or a size mismatches.
+    [[nodiscard]] BSAPI std::optional<PatchedPacket> patched(std::span<const std::string_view> values) const;
+
+    // Encodes each value with the packet's endianness and patches it into the field at the same position
+    template <detail::BulkArithmetic... Ts>
+    [[nodiscard]] std::optional<PatchedPacket> forRecipient(Ts... values) const {
+        auto encode = [this](auto value) {
+            if (mBigEndian) { value = detail::swapEndian(value); }
+            return std::bit_cast<std::array<char, sizeof(value)>>(value);
+        };
+        std::tuple encoded{encode(values)...};
+        return std::apply(
+            [this](auto const&... bytes) {
+                std::array<std::string_view, sizeof...(Ts)> views{std::string_view(bytes.data(), bytes.size())...};
+                return patched(views);
+            },
+            encoded
+        );
+    }
+};
+
+// Deduplicates identical payloads so repeated broadcasts share one SharedBuffer. Entries live until clear(), which is
+// meant to be called once per tick.
+class BroadcastCache {
+    std::unordered_map<std::string_view, SharedBuffer> mEntries;
+
+public:
+    // Returns the cached buffer holding the same bytes, storing a copy of payload on a miss
+    [[nodiscard]] BSAPI SharedBuffer intern(std::string_view payload);
+    // Same as above, but takes the stream's buffer without copying on a miss. The stream is released either way.
+    [[nodiscard]] BSAPI SharedBuffer intern(BinaryStream& stream);
+
+    [[nodiscard]] BSAPI size_t size() const noexcept;
+    BSAPI void                 clear() noexcept;
+};
+
+} // namespace bstream
@@ -0,0 +1,61 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <binarystream/BinaryStream.hpp>
+
+namespace bstream {
+
+// CRC-32C (Castagnoli), using SSE4.2 or ARMv8 CRC instructions when available
+class Crc32c {
+    uint32_t mState;
+
+public:
+    constexpr Crc32c() noexcept : mState(0xFFFFFFFF) {}
+
+    BSAPI void update(const void* data, size_t size) noexcept;
+    void       update(std::string_view data) noexcept { update(data.data(), data.size()); }
+
+    constexpr void reset() noexcept { mState = 0xFFFFFFFF; }
+
+    [[nodiscard]] constexpr uint32_t digest() const noexcept { return ~mState; }
+
+    [[nodiscard]] BSAPI static uint32_t compute(std::string_view data) noexcept;
+};
+
+// Helper that keeps a running CRC-32C over a region of a stream it observes from outside: bytes consumed by a
+// ReadOnlyBinaryStream, or bytes appended to a BinaryStream. The stream itself does not call into it; each update()
+// folds in only the bytes added since the previous call, so calling it after every record hashes the data while it
+// is still in cache and never scans the same bytes twice.
+class ChecksumTracker {
+    ReadOnlyBinaryStream const* mStream;
+    bool                        mTracksWrites;
+    size_t                      mRegionStart;
+    size_t                      mPosition;
+    Crc32c                      mCrc;
+
+    [[nodiscard]] size_t currentPosition() const noexcept;
+
+public:
+    [[nodiscard]] BSAPI explicit ChecksumTracker(ReadOnlyBinaryStream const& stream) noexcept;
+    [[nodiscard]] BSAPI explicit ChecksumTracker(BinaryStream const& stream) noexcept;
+
+    // Starts a new region at the current read position or write end
+    BSAPI void mark() noexcept;
+
+    // Folds in the bytes added since the last call. If the stream was reset or rewound meanwhile, the region restarts
+    // at the new position.
+    BSAPI uint32_t update() noexcept;
+
+    // Returns the digest of the region and starts a new one
+    BSAPI uint32_t finalize() noexcept;
+
+    [[nodiscard]] BSAPI size_t regionStart() const noexcept;
+    [[nodiscard]] BSAPI size_t regionSize() const noexcept;
+};
+
+} // namespace bstream
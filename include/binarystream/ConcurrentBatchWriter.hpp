@@ -0,0 +1,66 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <binarystream/SpanBinaryStream.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace bstream {
+
+// Assembles one batch from many threads. Each thread atomically reserves a region of a shared block, serializes its
+// packet in place and commits it; when a block is full the next one is used. Packets appear in reservation order.
+// reserve() and commit() may be called concurrently; segments(), seal() and reset() only once every writer has
+// finished. Blocks are kept across batches, so a writer reused for many batches stops allocating.
+class ConcurrentBatchWriter {
+    struct Block {
+        std::string         mData;
+        std::atomic<size_t> mUsed;
+        std::atomic<size_t> mEnd;
+
+        explicit Block(size_t capacity);
+        [[nodiscard]] size_t size() const noexcept;
+        void                 clear() noexcept;
+    };
+
+    std::atomic<Block*>                 mCurrent;
+    std::vector<std::unique_ptr<Block>> mBlocks;
+    size_t                              mCurrentIndex;
+    std::mutex                          mGrowMutex;
+    std::atomic<size_t>                 mPending;
+    std::atomic<bool>                   mHasFailed;
+    size_t                              mBlockSize;
+    bool                                mBigEndian;
+
+    void grow(Block* full, size_t size);
+
+public:
+    // The first block holds blockSize bytes; pass the expected batch size to keep the batch in one block
+    [[nodiscard]] BSAPI explicit ConcurrentBatchWriter(size_t blockSize, bool bigEndian = false);
+
+    ConcurrentBatchWriter(ConcurrentBatchWriter const&)            = delete;
+    ConcurrentBatchWriter& operator=(ConcurrentBatchWriter const&) = delete;
+
+    // Reserves exactly size bytes; the packet written to the returned stream must fill them and then be committed
+    [[nodiscard]] BSAPI SpanBinaryStream reserve(size_t size);
+
+    // Returns false, and makes seal() fail, if the packet overflowed or left part of its reservation unwritten
+    BSAPI bool commit(SpanBinaryStream const& packet) noexcept;
+
+    [[nodiscard]] BSAPI size_t                        size() const noexcept;
+    [[nodiscard]] BSAPI std::vector<std::string_view> segments() const;
+
+    // Replaces batch with the contiguous batch and resets the writer. A batch that fits one block is swapped out
+    // without copying, and batch's previous buffer becomes that block, so passing the same string every time reuses
+    // its allocation. Returns false and leaves batch empty if a reservation was not committed or failed its commit.
+    [[nodiscard]] BSAPI bool seal(std::string& batch);
+    BSAPI void               reset() noexcept;
+};
+
+} // namespace bstream
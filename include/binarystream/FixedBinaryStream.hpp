@@ -0,0 +1,72 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <binarystream/SizeMeasuringStream.hpp>
+
+namespace bstream {
+
+// Writes into N bytes of inline storage and never allocates. Like SpanBinaryStream, a write that does not fit is
+// dropped and marks the stream as overflowed.
+template <size_t N>
+class FixedBinaryStream : public BasicBinaryWriter<FixedBinaryStream<N>> {
+    friend class BasicBinaryWriter<FixedBinaryStream<N>>;
+
+    std::array<char, N> mStorage;
+    size_t              mSize;
+    bool                mHasOverflowed;
+    bool                mBigEndian;
+
+    constexpr void appendBytes(const char* data, size_t size) noexcept {
+        if (mHasOverflowed || size > N - mSize) {
+            mHasOverflowed = true;
+            return;
+        }
+        std::copy_n(data, size, mStorage.data() + mSize);
+        mSize += size;
+    }
+
+    [[nodiscard]] constexpr bool isBigEndian() const noexcept { return mBigEndian; }
+
+public:
+    [[nodiscard]] constexpr explicit FixedBinaryStream(bool bigEndian = false) noexcept
+    : mSize(0),
+      mHasOverflowed(false),
+      mBigEndian(bigEndian) {}
+
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return N; }
+
+    [[nodiscard]] constexpr size_t      size() const noexcept { return mSize; }
+    [[nodiscard]] constexpr bool        isOverflowed() const noexcept { return mHasOverflowed; }
+    [[nodiscard]] constexpr const char* data() const noexcept { return mStorage.data(); }
+
+    [[nodiscard]] constexpr std::string_view view() const noexcept { return std::string_view(mStorage.data(), mSize); }
+
+    // Only the first size() bytes have been written
+    [[nodiscard]] constexpr std::array<char, N> const& storage() const noexcept { return mStorage; }
+
+    constexpr void reset() noexcept {
+        mSize          = 0;
+        mHasOverflowed = false;
+    }
+};
+
+// Runs Encoder (a captureless callable taking a writer by reference) at compile time and returns exactly the bytes it
+// writes, e.g. constexpr auto packet = encodePacket<[](auto& out) { out.writeString("pong"); }>();
+template <auto Encoder, bool BigEndian = false>
+consteval auto encodePacket() {
+    constexpr size_t size = [] {
+        SizeMeasuringStream measure(BigEndian);
+        Encoder(measure);
+        return measure.size();
+    }();
+    FixedBinaryStream<size> stream(BigEndian);
+    Encoder(stream);
+    return stream.storage();
+}
+
+} // namespace bstream
@@ -0,0 +1,39 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <binarystream-c/Macros.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace bstream {
+
+// Fixed-width indices packed into 32-bit words, lowest bits first, with no entry crossing a word boundary
+class PackedBitArray {
+public:
+    static constexpr uint8_t MaxBitsPerEntry = 16;
+
+    [[nodiscard]] static constexpr bool isValidBitsPerEntry(uint8_t bitsPerEntry) noexcept {
+        return bitsPerEntry >= 1 && bitsPerEntry <= MaxBitsPerEntry;
+    }
+
+    [[nodiscard]] static constexpr size_t entriesPerWord(uint8_t bitsPerEntry) noexcept {
+        return isValidBitsPerEntry(bitsPerEntry) ? 32 / bitsPerEntry : 0;
+    }
+
+    [[nodiscard]] static constexpr size_t wordCount(size_t entryCount, uint8_t bitsPerEntry) noexcept {
+        size_t perWord = entriesPerWord(bitsPerEntry);
+        return perWord == 0 ? 0 : (entryCount + perWord - 1) / perWord;
+    }
+
+    BSAPI static bool pack(std::span<const uint16_t> entries, uint8_t bitsPerEntry, std::span<uint32_t> words) noexcept;
+    BSAPI static bool
+    unpack(std::span<const uint32_t> words, uint8_t bitsPerEntry, std::span<uint16_t> entries) noexcept;
+};
+
+} // namespace bstream
@@ -9,14 +9,18 @@
 #include <algorithm>
 #include <array>
 #include <binarystream-c/Macros.h>
+#include <binarystream/SharedBuffer.hpp>
 #include <bit>
 #include <cstdint>
+#include <span>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
 namespace bstream {
 
+class BinaryReader;
 class BinaryStream;
 
 namespace detail {
@@ -31,22 +35,102 @@ template <typename T>
         return std::bit_cast<T>(bytes);
     }
 }
+
+// Reads a T from the first sizeof(T) bytes of data, which are in big-endian order if bigEndian is set
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+[[nodiscard]] constexpr T loadFixed(const char* data, bool bigEndian) noexcept {
+    std::array<char, sizeof(T)> bytes;
+    std::copy_n(data, sizeof(T), bytes.begin());
+    auto value = std::bit_cast<T>(bytes);
+    return bigEndian ? swapEndian(value) : value;
+}
+
+[[nodiscard]] BSAPI bool isValidUtf8(std::string_view text) noexcept;
+
+// Reverses the byte order of each of count elements of elementSize (2, 4 or 8) bytes in place
+BSAPI void swapEndianArray(void* data, size_t count, size_t elementSize) noexcept;
+
+// Bulk decoders shared by ReadOnlyBinaryStream and BinaryReader. Each decodes values.size() elements from the front of
+// unread and stores the number of bytes it used in consumed; false means the data is truncated or malformed.
+BSAPI bool decodePackedBitArray(
+    std::string_view    unread,
+    size_t&             consumed,
+    std::span<uint16_t> entries,
+    uint8_t             bitsPerEntry,
+    bool                bigEndian
+);
+BSAPI bool decodeDeltaVarInts(std::string_view unread, size_t& consumed, std::span<int32_t> values);
+BSAPI bool decodeDeltaVarInt64s(std::string_view unread, size_t& consumed, std::span<int64_t> values);
+BSAPI bool decodeFrameOfReference(std::string_view unread, size_t& consumed, std::span<uint32_t> values);
+BSAPI bool decodeXorFloats(std::string_view unread, size_t& consumed, std::span<float> values);
+BSAPI bool decodeXorDoubles(std::string_view unread, size_t& consumed, std::span<double> values);
+BSAPI bool decodeNormalizedFloats(std::string_view unread, size_t& consumed, std::span<float> values, bool bigEndian);
+BSAPI bool decodeHalfFloats(std::string_view unread, size_t& consumed, std::span<float> values, bool bigEndian);
+BSAPI bool decodeFixed16Floats(
+    std::string_view unread,
+    size_t&          consumed,
+    std::span<float> values,
+    uint8_t          fractionalBits,
+    bool             bigEndian
+);
+BSAPI bool decodeFixed32Floats(
+    std::string_view unread,
+    size_t&          consumed,
+    std::span<float> values,
+    uint8_t          fractionalBits,
+    bool             bigEndian
+);
+BSAPI bool decodePrefixVarInts(std::string_view unread, size_t& consumed, std::span<uint64_t> values) noexcept;
+BSAPI bool decodeGroupVarInts(std::string_view unread, size_t& consumed, std::span<uint32_t> values) noexcept;
+
+// Element types with a fixed-width wire encoding: swapEndianArray handles only 2, 4 and 8 byte elements, so long double
+// and other wider types are excluded rather than written in a platform-specific layout
+template <typename T>
+concept BulkArithmetic = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>
+                      && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
 } // namespace detail
 
 class ReadOnlyBinaryStream {
+    friend class BinaryReader;
     friend class BinaryStream;
 
 protected:
     std::string      mOwnedBuffer;
+    SharedBuffer     mSharedBuffer;
     std::string_view mBufferView;
     size_t           mReadPointer;
     bool             mHasOverflowed;
+    bool             mValidateUtf8;
     const bool       mBigEndian;
 
 private:
     template <typename T>
     bool read(T* target, bool bigEndian = false) noexcept;
 
+    template <typename T>
+    T readVarInt() noexcept;
+
+    // Runs a shared bulk decoder over the unread bytes and moves past what it used, or marks the stream overflowed
+    template <typename Decode>
+    bool decodeUnread(Decode&& decode) {
+        if (mHasOverflowed) { return false; }
+        size_t consumed = 0;
+        if (!decode(unreadView(), consumed)) {
+            mHasOverflowed = true;
+            return false;
+        }
+        mReadPointer += consumed;
+        return true;
+    }
+
+    bool checkUtf8(std::string_view text) noexcept;
+    void readString(std::string& outString, size_t length);
+
+    [[nodiscard]] bool                 ownsBuffer() const noexcept;
+    [[nodiscard]] std::string_view     unreadView() const noexcept;
+    [[nodiscard]] ReadOnlyBinaryStream overflowedSlice() const;
+
 public:
     [[nodiscard]] BSAPI explicit ReadOnlyBinaryStream(
         std::string_view buffer,
@@ -70,6 +154,10 @@ public:
         bool           copyBuffer = false,
         bool           bigEndian  = false
     );
+    [[nodiscard]] BSAPI explicit ReadOnlyBinaryStream(SharedBuffer buffer, bool bigEndian = false);
+
+    [[nodiscard]] BSAPI ReadOnlyBinaryStream(ReadOnlyBinaryStream const& other);
+    [[nodiscard]] BSAPI ReadOnlyBinaryStream(ReadOnlyBinaryStream&& other) noexcept;
 
     [[nodiscard]] BSAPI size_t size() const noexcept;
     [[nodiscard]] BSAPI size_t getPosition() const noexcept;
@@ -85,6 +173,10 @@ public:
     [[nodiscard]] BSAPI std::string copyData() const;
     [[nodiscard]] BSAPI bool        operator==(ReadOnlyBinaryStream const&) const noexcept;
 
+    // When enabled, string reads reject malformed UTF-8 by marking the stream as overflowed
+    BSAPI void               setUtf8Validation(bool enabled) noexcept;
+    [[nodiscard]] BSAPI bool isUtf8ValidationEnabled() const noexcept;
+
     BSAPI bool          getBytes(void* target, size_t num) noexcept;
     [[nodiscard]] BSAPI std::byte getByte() noexcept;
     [[nodiscard]] BSAPI uint8_t   getUnsignedChar() noexcept;
@@ -119,6 +211,41 @@ public:
 
     BSAPI void          getRawBytes(std::string& rawBuffer, size_t length);
     [[nodiscard]] BSAPI std::string getRawBytes(size_t length);
+
+    // Slices share storage with a SharedBuffer-backed stream, borrow the same memory from a borrowing stream, and
+    // copy the range into a new SharedBuffer when this stream owns a private copy. Out-of-range slices are overflowed.
+    [[nodiscard]] BSAPI ReadOnlyBinaryStream slice(size_t offset, size_t length) const;
+    [[nodiscard]] BSAPI ReadOnlyBinaryStream readSlice(size_t length);
+    [[nodiscard]] BSAPI SharedBuffer const&  sharedBuffer() const noexcept;
+
+    // Reads PackedBitArray::wordCount(entries.size(), bitsPerEntry) words and unpacks them into entries
+    BSAPI bool getPackedBitArray(std::span<uint16_t> entries, uint8_t bitsPerEntry);
+
+    // Sequence decoders for the matching BinaryStream encoders; values.size() elements are decoded
+    BSAPI bool getDeltaVarInts(std::span<int32_t> values);
+    BSAPI bool getDeltaVarInt64s(std::span<int64_t> values);
+    BSAPI bool getFrameOfReference(std::span<uint32_t> values);
+    BSAPI bool getXorFloats(std::span<float> values);
+    BSAPI bool getXorDoubles(std::span<double> values);
+
+    // Bulk float decoders for the matching BinaryStream encoders
+    BSAPI bool getNormalizedFloats(std::span<float> values);
+    BSAPI bool getHalfFloats(std::span<float> values);
+    BSAPI bool getFixed16Floats(std::span<float> values, uint8_t fractionalBits);
+    BSAPI bool getFixed32Floats(std::span<float> values, uint8_t fractionalBits);
+
+    // Decoders for BinaryStream::writePrefixVarInt(s) and writeGroupVarInts
+    [[nodiscard]] BSAPI uint64_t getPrefixVarInt() noexcept;
+    BSAPI bool                   getPrefixVarInts(std::span<uint64_t> values);
+    BSAPI bool                   getGroupVarInts(std::span<uint32_t> values);
+
+    // Reads values.size() fixed-width elements with a single bounds check
+    template <detail::BulkArithmetic T>
+    bool getArray(std::span<T> values) noexcept {
+        if (!getBytes(values.data(), values.size_bytes())) { return false; }
+        if (mBigEndian) { detail::swapEndianArray(values.data(), values.size(), sizeof(T)); }
+        return true;
+    }
 };
 
 } // namespace bstream
\ No newline at end of file
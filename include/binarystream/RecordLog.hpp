@@ -0,0 +1,82 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <binarystream/BinaryStream.hpp>
+#include <optional>
+#include <vector>
+
+namespace bstream {
+
+// Record log layout:
+//   header  "BSRL" + version byte
+//   records timestamp (varint64) + payload length (unsigned varint64) + payload
+//   index   recordCount * (offset uint64 + timestamp int64), offsets relative to the start of the log
+//   trailer index offset (uint64) + record count (uint64) + "BSRI"
+// Fixed-width fields use the BinaryStream writers and readers.
+// A log without a valid trailer, e.g. from an interrupted capture, is indexed by scanning its records.
+struct RecordLogEntry {
+    uint64_t mOffset;
+    int64_t  mTimestamp;
+};
+
+class RecordLogWriter {
+    BinaryStream                mStream;
+    uint64_t                    mDrainedBytes;
+    std::vector<RecordLogEntry> mIndex;
+    bool                        mFinished;
+
+public:
+    [[nodiscard]] BSAPI RecordLogWriter();
+
+    // Movable, since BinaryStream rebinds its buffer on move; copying would fork one capture into two logs
+    [[nodiscard]] RecordLogWriter(RecordLogWriter&&) noexcept = default;
+
+    RecordLogWriter(RecordLogWriter const&)            = delete;
+    RecordLogWriter& operator=(RecordLogWriter const&) = delete;
+
+    // Fails once finished or if timestamp is lower than the previous record's
+    BSAPI bool append(int64_t timestamp, std::string_view payload);
+
+    [[nodiscard]] BSAPI size_t recordCount() const noexcept;
+
+    // Returns the bytes produced since the last drain, to be appended to the output file
+    [[nodiscard]] BSAPI std::string drain();
+    // Appends the index and trailer and returns the remaining bytes
+    [[nodiscard]] BSAPI std::string finish();
+};
+
+class RecordLogReader {
+    ReadOnlyBinaryStream        mStream;
+    std::string_view            mIndex;
+    std::vector<RecordLogEntry> mRebuiltIndex;
+    size_t                      mRecordCount;
+    bool                        mIsValid;
+    bool                        mIsIndexRebuilt;
+
+    void load();
+    bool loadFooter();
+    void rebuildIndex();
+
+public:
+    // Borrows data, e.g. a memory-mapped capture, which must outlive the reader and the records it returns
+    [[nodiscard]] BSAPI explicit RecordLogReader(std::string_view data);
+    [[nodiscard]] BSAPI explicit RecordLogReader(SharedBuffer data);
+
+    [[nodiscard]] BSAPI bool   isValid() const noexcept;
+    [[nodiscard]] BSAPI bool   isIndexRebuilt() const noexcept;
+    [[nodiscard]] BSAPI size_t recordCount() const noexcept;
+
+    [[nodiscard]] BSAPI RecordLogEntry entry(size_t index) const noexcept;
+    // Payload of record index, sharing storage with the log
+    [[nodiscard]] BSAPI std::optional<ReadOnlyBinaryStream> record(size_t index) const;
+
+    // Index of the first record with a timestamp not less than timestamp, or recordCount() if there is none
+    [[nodiscard]] BSAPI size_t lowerBound(int64_t timestamp) const noexcept;
+};
+
+} // namespace bstream
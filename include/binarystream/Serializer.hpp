@@ -0,0 +1,324 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <binarystream/BinaryStream.hpp>
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace bstream {
+
+// Customization point for bstream::write and bstream::read. A specialization provides
+//   template <typename Writer> static void write(Writer& out, T const& value);
+//   template <typename Reader> static bool read(Reader& in, T& value);
+// where Writer is BinaryStream or any BasicBinaryWriter and Reader is ReadOnlyBinaryStream or BinaryReader. Nested
+// values must be written with the qualified bstream::write/bstream::read, since the static members hide the free
+// functions. It may also declare
+//   static constexpr size_t MinEncodedSize;
+// the fewest bytes any value encodes to, 1 if omitted. Containers reject element counts that the remaining bytes
+// cannot hold. A type that can encode to nothing declares 0; its containers are still limited to one element per
+// remaining byte, so a hostile count cannot drive an unbounded read loop.
+template <typename T>
+struct Serializer;
+
+template <typename T>
+concept Serializable = requires { sizeof(Serializer<T>); };
+
+template <typename Writer, Serializable T>
+void write(Writer& out, T const& value) {
+    Serializer<T>::write(out, value);
+}
+
+// Returns false if the data is malformed or truncated
+template <typename Reader, Serializable T>
+bool read(Reader& in, T& value) {
+    return Serializer<T>::read(in, value) && !in.isOverflowed();
+}
+
+namespace detail {
+
+template <typename Reader>
+size_t remainingBytes(Reader const& in) noexcept {
+    return in.getPosition() < in.size() ? in.size() - in.getPosition() : 0;
+}
+
+template <typename T>
+constexpr size_t minEncodedSize() noexcept {
+    if constexpr (requires { Serializer<T>::MinEncodedSize; }) {
+        return Serializer<T>::MinEncodedSize;
+    } else {
+        return 1;
+    }
+}
+
+// A count larger than the remaining bytes can hold is malformed and is rejected before anything is reserved
+template <typename T, typename Reader>
+bool readCount(Reader& in, size_t& count) {
+    uint64_t value = in.getUnsignedVarInt64();
+    if (in.isOverflowed()) { return false; }
+    if (value > remainingBytes(in) / std::max<size_t>(minEncodedSize<T>(), 1)) { return false; }
+    count = static_cast<size_t>(value);
+    return true;
+}
+
+template <size_t Size>
+using FixedWidthBits = std::conditional_t<
+    Size == 1,
+    uint8_t,
+    std::conditional_t<Size == 2, uint16_t, std::conditional_t<Size == 4, uint32_t, uint64_t>>>;
+
+} // namespace detail
+
+// Fixed-width, through the unsigned writer and reader of the same width
+template <detail::BulkArithmetic T>
+struct Serializer<T> {
+    using Bits = detail::FixedWidthBits<sizeof(T)>;
+
+    static constexpr size_t MinEncodedSize = sizeof(T);
+
+    template <typename Writer>
+    static void write(Writer& out, T value) {
+        auto bits = std::bit_cast<Bits>(value);
+        if constexpr (sizeof(T) == 1) {
+            out.writeUnsignedChar(bits);
+        } else if constexpr (sizeof(T) == 2) {
+            out.writeUnsignedShort(bits);
+        } else if constexpr (sizeof(T) == 4) {
+            out.writeUnsignedInt(bits);
+        } else {
+            out.writeUnsignedInt64(bits);
+        }
+    }
+    template <typename Reader>
+    static bool read(Reader& in, T& value) {
+        Bits bits;
+        if constexpr (sizeof(T) == 1) {
+            bits = in.getUnsignedChar();
+        } else if constexpr (sizeof(T) == 2) {
+            bits = in.getUnsignedShort();
+        } else if constexpr (sizeof(T) == 4) {
+            bits = in.getUnsignedInt();
+        } else {
+            bits = in.getUnsignedInt64();
+        }
+        value = std::bit_cast<T>(bits);
+        return !in.isOverflowed();
+    }
+};
+
+template <>
+struct Serializer<bool> {
+    template <typename Writer>
+    static void write(Writer& out, bool value) {
+        out.writeBool(value);
+    }
+    template <typename Reader>
+    static bool read(Reader& in, bool& value) {
+        value = in.getBool();
+        return !in.isOverflowed();
+    }
+};
+
+template <typename T>
+    requires std::is_enum_v<T>
+struct Serializer<T> {
+    using Underlying = std::underlying_type_t<T>;
+
+    static constexpr size_t MinEncodedSize = detail::minEncodedSize<Underlying>();
+
+    template <typename Writer>
+    static void write(Writer& out, T value) {
+        bstream::write(out, static_cast<Underlying>(value));
+    }
+    template <typename Reader>
+    static bool read(Reader& in, T& value) {
+        Underlying underlying{};
+        if (!bstream::read(in, underlying)) { return false; }
+        value = static_cast<T>(underlying);
+        return true;
+    }
+};
+
+// Same encoding as writeString
+template <>
+struct Serializer<std::string> {
+    template <typename Writer>
+    static void write(Writer& out, std::string const& value) {
+        out.writeString(value);
+    }
+    template <typename Reader>
+    static bool read(Reader& in, std::string& value) {
+        in.getString(value);
+        return !in.isOverflowed();
+    }
+};
+
+// Unsigned varint count followed by the elements; arithmetic elements are copied in bulk
+template <Serializable T, typename Allocator>
+struct Serializer<std::vector<T, Allocator>> {
+    template <typename Writer>
+    static void write(Writer& out, std::vector<T, Allocator> const& values) {
+        out.writeUnsignedVarInt64(values.size());
+        if constexpr (detail::BulkArithmetic<T>) {
+            out.template writeArray<T>(values);
+        } else {
+            for (auto const& value : values) { bstream::write(out, value); }
+        }
+    }
+    template <typename Reader>
+    static bool read(Reader& in, std::vector<T, Allocator>& values) {
+        size_t count;
+        if (!detail::readCount<T>(in, count)) { return false; }
+        values.clear();
+        if constexpr (detail::BulkArithmetic<T>) {
+            values.resize(count);
+            return in.template getArray<T>(values);
+        } else {
+            values.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                T value{};
+                if (!bstream::read(in, value)) { return false; }
+                values.push_back(std::move(value));
+            }
+            return true;
+        }
+    }
+};
+
+// No count, since N is known to both sides
+template <Serializable T, size_t N>
+struct Serializer<std::array<T, N>> {
+    static constexpr size_t MinEncodedSize = detail::minEncodedSize<T>() * N;
+
+    template <typename Writer>
+    static void write(Writer& out, std::array<T, N> const& values) {
+        if constexpr (detail::BulkArithmetic<T>) {
+            out.template writeArray<T>(values);
+        } else {
+            for (auto const& value : values) { bstream::write(out, value); }
+        }
+    }
+    template <typename Reader>
+    static bool read(Reader& in, std::array<T, N>& values) {
+        if constexpr (detail::BulkArithmetic<T>) {
+            return in.template getArray<T>(values);
+        } else {
+            for (auto& value : values) {
+                if (!bstream::read(in, value)) { return false; }
+            }
+            return true;
+        }
+    }
+};
+
+// Presence as a bool, then the value if present
+template <Serializable T>
+struct Serializer<std::optional<T>> {
+    template <typename Writer>
+    static void write(Writer& out, std::optional<T> const& value) {
+        out.writeBool(value.has_value());
+        if (value) { bstream::write(out, *value); }
+    }
+    template <typename Reader>
+    static bool read(Reader& in, std::optional<T>& value) {
+        bool present = in.getBool();
+        if (in.isOverflowed()) { return false; }
+        if (!present) {
+            value.reset();
+            return true;
+        }
+        return bstream::read(in, value.emplace());
+    }
+};
+
+template <Serializable First, Serializable Second>
+struct Serializer<std::pair<First, Second>> {
+    static constexpr size_t MinEncodedSize = detail::minEncodedSize<First>() + detail::minEncodedSize<Second>();
+
+    template <typename Writer>
+    static void write(Writer& out, std::pair<First, Second> const& value) {
+        bstream::write(out, value.first);
+        bstream::write(out, value.second);
+    }
+    template <typename Reader>
+    static bool read(Reader& in, std::pair<First, Second>& value) {
+        return bstream::read(in, value.first) && bstream::read(in, value.second);
+    }
+};
+
+namespace detail {
+
+// Unsigned varint count followed by key/value pairs in iteration order
+template <typename Map>
+struct MapSerializer {
+    using Key    = typename Map::key_type;
+    using Mapped = typename Map::mapped_type;
+
+    template <typename Writer>
+    static void write(Writer& out, Map const& values) {
+        out.writeUnsignedVarInt64(values.size());
+        for (auto const& [key, value] : values) {
+            bstream::write(out, key);
+            bstream::write(out, value);
+        }
+    }
+    template <typename Reader>
+    static bool read(Reader& in, Map& values) {
+        size_t count;
+        if (!readCount<std::pair<Key, Mapped>>(in, count)) { return false; }
+        values.clear();
+        if constexpr (requires { values.reserve(count); }) { values.reserve(count); }
+        for (size_t i = 0; i < count; ++i) {
+            Key    key{};
+            Mapped value{};
+            if (!bstream::read(in, key) || !bstream::read(in, value)) { return false; }
+            values.insert_or_assign(std::move(key), std::move(value));
+        }
+        return true;
+    }
+};
+
+} // namespace detail
+
+template <Serializable Key, Serializable Value, typename Compare, typename Allocator>
+struct Serializer<std::map<Key, Value, Compare, Allocator>>
+: detail::MapSerializer<std::map<Key, Value, Compare, Allocator>> {};
+
+template <Serializable Key, Serializable Value, typename Hash, typename Equal, typename Allocator>
+struct Serializer<std::unordered_map<Key, Value, Hash, Equal, Allocator>>
+: detail::MapSerializer<std::unordered_map<Key, Value, Hash, Equal, Allocator>> {};
+
+// Alternative index as an unsigned varint, then the active alternative
+template <Serializable... Ts>
+struct Serializer<std::variant<Ts...>> {
+    template <typename Writer>
+    static void write(Writer& out, std::variant<Ts...> const& value) {
+        out.writeUnsignedVarInt64(value.index());
+        std::visit([&out](auto const& alternative) { bstream::write(out, alternative); }, value);
+    }
+    template <typename Reader>
+    static bool read(Reader& in, std::variant<Ts...>& value) {
+        uint64_t index = in.getUnsignedVarInt64();
+        if (in.isOverflowed() || index >= sizeof...(Ts)) { return false; }
+        return readAlternative(in, value, static_cast<size_t>(index), std::index_sequence_for<Ts...>{});
+    }
+
+private:
+    template <typename Reader, size_t... Is>
+    static bool readAlternative(Reader& in, std::variant<Ts...>& value, size_t index, std::index_sequence<Is...>) {
+        bool result = false;
+        ((Is == index ? (result = bstream::read(in, value.template emplace<Is>()), true) : false) || ...);
+        return result;
+    }
+};
+
+} // namespace bstream
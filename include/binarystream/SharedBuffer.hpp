@@ -0,0 +1,34 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <binarystream-c/Macros.h>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace bstream {
+
+// Immutable, reference-counted byte storage that streams and slices can share across threads
+class SharedBuffer {
+    std::shared_ptr<const std::string> mStorage;
+
+public:
+    [[nodiscard]] SharedBuffer() noexcept = default;
+    [[nodiscard]] BSAPI explicit SharedBuffer(std::string&& buffer);
+    [[nodiscard]] BSAPI explicit SharedBuffer(std::string_view buffer);
+
+    [[nodiscard]] BSAPI std::string_view view() const noexcept;
+    [[nodiscard]] BSAPI const char*      data() const noexcept;
+    [[nodiscard]] BSAPI size_t           size() const noexcept;
+    [[nodiscard]] BSAPI bool             empty() const noexcept;
+    [[nodiscard]] BSAPI long             useCount() const noexcept;
+
+    [[nodiscard]] BSAPI explicit operator bool() const noexcept;
+};
+
+} // namespace bstream
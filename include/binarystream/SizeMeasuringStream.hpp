@@ -0,0 +1,95 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <binarystream/BasicBinaryWriter.hpp>
+#include <binarystream/PackedBitArray.hpp>
+
+namespace bstream {
+
+namespace detail {
+// Encoded sizes of the bulk encoders, computed without producing any bytes
+[[nodiscard]] BSAPI size_t measureDeltaVarInts(std::span<const int32_t> values) noexcept;
+[[nodiscard]] BSAPI size_t measureDeltaVarInt64s(std::span<const int64_t> values) noexcept;
+[[nodiscard]] BSAPI size_t measureFrameOfReference(std::span<const uint32_t> values) noexcept;
+[[nodiscard]] BSAPI size_t measureXorFloats(std::span<const float> values) noexcept;
+[[nodiscard]] BSAPI size_t measureXorDoubles(std::span<const double> values) noexcept;
+[[nodiscard]] BSAPI size_t measureNormalizedFloats(std::span<const float> values, bool bigEndian) noexcept;
+[[nodiscard]] BSAPI size_t measurePrefixVarInts(std::span<const uint64_t> values) noexcept;
+[[nodiscard]] BSAPI size_t measureGroupVarInts(std::span<const uint32_t> values) noexcept;
+} // namespace detail
+
+// Accepts the BinaryStream write API but only counts the bytes that would be written, so a serializer can be run
+// once against it to size a buffer exactly before the real pass. The bulk writers add up encoded lengths without
+// encoding anything.
+class SizeMeasuringStream : public BasicBinaryWriter<SizeMeasuringStream> {
+    friend class BasicBinaryWriter<SizeMeasuringStream>;
+
+    size_t mSize;
+    bool   mBigEndian;
+
+    constexpr void appendBytes(const char*, size_t size) noexcept { mSize += size; }
+
+    [[nodiscard]] constexpr bool isBigEndian() const noexcept { return mBigEndian; }
+
+public:
+    [[nodiscard]] constexpr explicit SizeMeasuringStream(bool bigEndian = false) noexcept
+    : mSize(0),
+      mBigEndian(bigEndian) {}
+
+    [[nodiscard]] constexpr size_t size() const noexcept { return mSize; }
+
+    constexpr void reset() noexcept { mSize = 0; }
+
+    bool writePackedBitArray(std::span<const uint16_t> entries, uint8_t bitsPerEntry) noexcept {
+        if (!PackedBitArray::isValidBitsPerEntry(bitsPerEntry)) { return false; }
+        mSize += PackedBitArray::wordCount(entries.size(), bitsPerEntry) * sizeof(uint32_t);
+        return true;
+    }
+
+    void writeDeltaVarInts(std::span<const int32_t> values) noexcept { mSize += detail::measureDeltaVarInts(values); }
+
+    void writeDeltaVarInt64s(std::span<const int64_t> values) noexcept {
+        mSize += detail::measureDeltaVarInt64s(values);
+    }
+
+    void writeFrameOfReference(std::span<const uint32_t> values) noexcept {
+        mSize += detail::measureFrameOfReference(values);
+    }
+
+    void writeXorFloats(std::span<const float> values) noexcept { mSize += detail::measureXorFloats(values); }
+
+    void writeXorDoubles(std::span<const double> values) noexcept { mSize += detail::measureXorDoubles(values); }
+
+    void writeNormalizedFloats(std::span<const float> values) noexcept {
+        mSize += detail::measureNormalizedFloats(values, mBigEndian);
+    }
+
+    void writeHalfFloats(std::span<const float> values) noexcept { mSize += values.size() * sizeof(uint16_t); }
+
+    bool writeFixed16Floats(std::span<const float> values, uint8_t fractionalBits) noexcept {
+        if (fractionalBits >= 16) { return false; }
+        mSize += values.size() * sizeof(int16_t);
+        return true;
+    }
+
+    bool writeFixed32Floats(std::span<const float> values, uint8_t fractionalBits) noexcept {
+        if (fractionalBits >= 32) { return false; }
+        mSize += values.size() * sizeof(int32_t);
+        return true;
+    }
+
+    void writePrefixVarInt(uint64_t value) noexcept { writePrefixVarInts(std::span<const uint64_t>(&value, 1)); }
+
+    void writePrefixVarInts(std::span<const uint64_t> values) noexcept {
+        mSize += detail::measurePrefixVarInts(values);
+    }
+
+    void writeGroupVarInts(std::span<const uint32_t> values) noexcept { mSize += detail::measureGroupVarInts(values); }
+};
+
+} // namespace bstream
@@ -0,0 +1,59 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <binarystream/BasicBinaryWriter.hpp>
+
+namespace bstream {
+
+// Writes into caller-owned memory of fixed capacity. A write that does not fit is dropped and marks the stream as
+// overflowed, after which all writes are ignored.
+class SpanBinaryStream : public BasicBinaryWriter<SpanBinaryStream> {
+    friend class BasicBinaryWriter<SpanBinaryStream>;
+
+    char*  mData;
+    size_t mCapacity;
+    size_t mSize;
+    bool   mHasOverflowed;
+    bool   mBigEndian;
+
+    void appendBytes(const char* data, size_t size) noexcept {
+        if (mHasOverflowed || size > mCapacity - mSize) {
+            mHasOverflowed = true;
+            return;
+        }
+        std::copy_n(data, size, mData + mSize);
+        mSize += size;
+    }
+
+    [[nodiscard]] bool isBigEndian() const noexcept { return mBigEndian; }
+
+public:
+    [[nodiscard]] SpanBinaryStream(void* data, size_t capacity, bool bigEndian = false) noexcept
+    : mData(static_cast<char*>(data)),
+      mCapacity(capacity),
+      mSize(0),
+      mHasOverflowed(false),
+      mBigEndian(bigEndian) {}
+
+    [[nodiscard]] explicit SpanBinaryStream(std::span<char> buffer, bool bigEndian = false) noexcept
+    : SpanBinaryStream(buffer.data(), buffer.size(), bigEndian) {}
+
+    [[nodiscard]] size_t size() const noexcept { return mSize; }
+    [[nodiscard]] size_t capacity() const noexcept { return mCapacity; }
+    [[nodiscard]] bool   isOverflowed() const noexcept { return mHasOverflowed; }
+    [[nodiscard]] char*  data() const noexcept { return mData; }
+
+    [[nodiscard]] std::string_view view() const noexcept { return std::string_view(mData, mSize); }
+
+    void reset() noexcept {
+        mSize          = 0;
+        mHasOverflowed = false;
+    }
+};
+
+} // namespace bstream
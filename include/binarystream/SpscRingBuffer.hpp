@@ -0,0 +1,61 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <binarystream/SpanBinaryStream.hpp>
+#include <atomic>
+#include <memory>
+#include <optional>
+
+namespace bstream {
+
+// Lock-free single-producer/single-consumer queue of length-framed records in one contiguous ring. Records never wrap
+// around the end of the ring, so the producer serializes straight into ring memory and the consumer reads each record
+// as one ReadOnlyBinaryStream without copying. One thread may call the producer functions and one other thread the
+// consumer functions.
+class SpscRingBuffer {
+    static constexpr size_t CacheLineSize = 64;
+
+    std::unique_ptr<char[]> mStorage;
+    size_t                  mCapacity;
+    bool                    mBigEndian;
+
+    alignas(CacheLineSize) std::atomic<size_t> mHead;
+    size_t mCachedTail;
+    size_t mReservedStart;
+    bool   mHasReservation;
+
+    alignas(CacheLineSize) std::atomic<size_t> mTail;
+    size_t mCachedHead;
+    size_t mReadIndex;
+    size_t mPendingRelease;
+
+    bool hasRoom(size_t head, size_t required);
+
+public:
+    // Capacity is rounded up to a power of two
+    [[nodiscard]] BSAPI explicit SpscRingBuffer(size_t capacity, bool bigEndian = false);
+
+    SpscRingBuffer(SpscRingBuffer const&)            = delete;
+    SpscRingBuffer& operator=(SpscRingBuffer const&) = delete;
+
+    [[nodiscard]] BSAPI size_t capacity() const noexcept;
+
+    // Producer: reserves room for a record of up to maxSize bytes. Returns nullopt if the ring is too full. A record
+    // that does not fit before the end of the ring first hands the rest of the ring to the consumer, so it may only
+    // fit once the consumer has polled past that gap.
+    [[nodiscard]] BSAPI std::optional<SpanBinaryStream> tryReserve(size_t maxSize);
+    // Publishes the record written to the reserved stream; an overflowed stream is discarded and false returned
+    BSAPI bool commit(SpanBinaryStream const& stream);
+    BSAPI bool tryPush(std::string_view record);
+
+    // Consumer: returns a view of the oldest record, valid until release()
+    [[nodiscard]] BSAPI std::optional<ReadOnlyBinaryStream> tryPop();
+    BSAPI void                                              release();
+};
+
+} // namespace bstream
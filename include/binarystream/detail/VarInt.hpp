@@ -0,0 +1,68 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace bstream::detail {
+
+constexpr size_t MaxVarInt64Length = 10;
+
+// LEB128, lowest seven bits first; writes at most MaxVarInt64Length bytes and returns the count. Byte is char or
+// uint8_t so that BasicBinaryWriter can encode in constant expressions.
+template <typename Byte>
+    requires(sizeof(Byte) == 1)
+constexpr size_t encodeVarInt(uint64_t value, Byte* out) noexcept {
+    size_t length = 0;
+    while (value >= 0x80) {
+        out[length++]   = static_cast<Byte>((value & 0x7F) | 0x80);
+        value         >>= 7;
+    }
+    out[length++] = static_cast<Byte>(value);
+    return length;
+}
+
+// The number of bytes encodeVarInt writes for value
+constexpr size_t varIntLength(uint64_t value) noexcept {
+    return static_cast<size_t>(std::bit_width(value | 1) + 6) / 7;
+}
+
+// Same limits as ReadOnlyBinaryStream::getUnsignedVarInt/getUnsignedVarInt64. On a truncated or over-long varint,
+// false is returned with cursor past the bytes read and value holding the bits decoded so far.
+template <typename T>
+    requires std::is_same_v<T, uint32_t> || std::is_same_v<T, uint64_t>
+constexpr bool decodeVarInt(const uint8_t*& cursor, const uint8_t* end, T& value) noexcept {
+    constexpr unsigned MaxShift = sizeof(T) == 4 ? 35 : 70;
+
+    value          = 0;
+    unsigned shift = 0;
+    while (true) {
+        if (shift >= MaxShift || cursor == end) { return false; }
+        uint8_t byte  = *cursor++;
+        value        |= static_cast<T>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) { return true; }
+        shift += 7;
+    }
+}
+
+template <typename T>
+    requires std::is_signed_v<T>
+constexpr std::make_unsigned_t<T> zigzagEncode(T value) noexcept {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<U>(static_cast<U>(value) << 1) ^ static_cast<U>(value >> (sizeof(T) * 8 - 1));
+}
+
+template <typename U>
+    requires std::is_unsigned_v<U>
+constexpr std::make_signed_t<U> zigzagDecode(U value) noexcept {
+    return static_cast<std::make_signed_t<U>>((value >> 1) ^ (U(0) - (value & 1)));
+}
+
+} // namespace bstream::detail
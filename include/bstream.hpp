@@ -6,4 +6,17 @@
 // SPDX-License-Identifier: MPL-2.0
 
 #pragma once
+#include <binarystream/AsyncBinaryStreamReader.hpp>
+#include <binarystream/BinaryReader.hpp>
 #include <binarystream/BinaryStream.hpp>
+#include <binarystream/BroadcastPacket.hpp>
+#include <binarystream/Checksum.hpp>
+#include <binarystream/ConcurrentBatchWriter.hpp>
+#include <binarystream/FixedBinaryStream.hpp>
+#include <binarystream/PackedBitArray.hpp>
+#include <binarystream/RecordLog.hpp>
+#include <binarystream/Serializer.hpp>
+#include <binarystream/SharedBuffer.hpp>
+#include <binarystream/SizeMeasuringStream.hpp>
+#include <binarystream/SpanBinaryStream.hpp>
+#include <binarystream/SpscRingBuffer.hpp>
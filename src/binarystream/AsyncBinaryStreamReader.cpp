@@ -0,0 +1,267 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "binarystream/AsyncBinaryStreamReader.hpp"
+#include "binarystream/detail/VarInt.hpp"
+#include <cstring>
+
+namespace bstream {
+
+namespace {
+
+constexpr size_t PullSize = 4096;
+
+struct ReadableAwaiter {
+    AsyncByteSource& mSource;
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> handle) { return mSource.waitReadable(handle); }
+    void await_resume() const noexcept {}
+};
+
+} // namespace
+
+PipeByteSource::PipeByteSource() : mOffset(0), mClosed(false) {}
+
+void PipeByteSource::push(std::string_view data) {
+    if (mOffset == mPending.size()) {
+        mPending.clear();
+        mOffset = 0;
+    }
+    mPending.append(data);
+    if (mWaiter && !data.empty()) { std::exchange(mWaiter, {}).resume(); }
+}
+
+void PipeByteSource::close() {
+    mClosed = true;
+    if (mWaiter) { std::exchange(mWaiter, {}).resume(); }
+}
+
+size_t PipeByteSource::readSome(char* buffer, size_t capacity) {
+    size_t length = std::min(capacity, mPending.size() - mOffset);
+    std::memcpy(buffer, mPending.data() + mOffset, length);
+    mOffset += length;
+    return length;
+}
+
+bool PipeByteSource::isClosed() const { return mClosed; }
+
+bool PipeByteSource::waitReadable(std::coroutine_handle<> waiter) {
+    if (mOffset < mPending.size() || mClosed) { return false; }
+    mWaiter = waiter;
+    return true;
+}
+
+AsyncBinaryStreamReader::AsyncBinaryStreamReader(AsyncByteSource& source, bool bigEndian)
+: mSource(source),
+  mPosition(0),
+  mMaxLength(DefaultMaxLength),
+  mHasOverflowed(false),
+  mBigEndian(bigEndian) {}
+
+bool AsyncBinaryStreamReader::isOverflowed() const noexcept { return mHasOverflowed; }
+
+size_t AsyncBinaryStreamReader::getMaxLength() const noexcept { return mMaxLength; }
+
+void AsyncBinaryStreamReader::setMaxLength(size_t value) noexcept { mMaxLength = value; }
+
+size_t AsyncBinaryStreamReader::buffered() const noexcept { return mBuffer.size() - mPosition; }
+
+bool AsyncBinaryStreamReader::pull() {
+    if (mPosition > 0 && mPosition * 2 >= mBuffer.size()) {
+        mBuffer.erase(0, mPosition);
+        mPosition = 0;
+    }
+    size_t offset = mBuffer.size();
+    mBuffer.resize(offset + PullSize);
+    size_t length = mSource.readSome(mBuffer.data() + offset, PullSize);
+    mBuffer.resize(offset + length);
+    return length > 0;
+}
+
+AsyncTask<bool> AsyncBinaryStreamReader::fill(size_t size) {
+    while (buffered() < size) {
+        if (pull()) { continue; }
+        if (mSource.isClosed()) {
+            mHasOverflowed = true;
+            co_return false;
+        }
+        co_await ReadableAwaiter{mSource};
+    }
+    co_return true;
+}
+
+// Pulls bytes the source already has until size are buffered, without waiting
+bool AsyncBinaryStreamReader::available(size_t size) {
+    while (buffered() < size) {
+        if (!pull()) { return false; }
+    }
+    return true;
+}
+
+void AsyncBinaryStreamReader::take(void* target, size_t size) noexcept {
+    std::memcpy(target, mBuffer.data() + mPosition, size);
+    mPosition += size;
+}
+
+template <typename T>
+T AsyncBinaryStreamReader::takeFixed() noexcept {
+    T value    = detail::loadFixed<T>(mBuffer.data() + mPosition, mBigEndian);
+    mPosition += sizeof(T);
+    return value;
+}
+
+// Decodes a varint from the buffered bytes; returns false if more bytes are needed. A varint longer than the maximum
+// sets the overflow flag and yields zero.
+template <typename T>
+bool AsyncBinaryStreamReader::tryVarInt(T& value) {
+    constexpr size_t MaxLength = sizeof(T) == 4 ? 5 : detail::MaxVarInt64Length;
+
+    value = 0;
+    while (!mHasOverflowed) {
+        auto begin  = reinterpret_cast<const uint8_t*>(mBuffer.data() + mPosition);
+        auto cursor = begin;
+        if (detail::decodeVarInt(cursor, begin + buffered(), value)) {
+            mPosition += static_cast<size_t>(cursor - begin);
+            if (mBigEndian) { value = detail::swapEndian(value); }
+            return true;
+        }
+        value = 0;
+        if (buffered() >= MaxLength) {
+            mHasOverflowed = true;
+            break;
+        }
+        if (!pull()) { return false; }
+    }
+    return true;
+}
+
+// Takes length buffered bytes into result; returns false if more bytes are needed
+bool AsyncBinaryStreamReader::tryRawBytes(std::string& result, size_t length) {
+    if (mHasOverflowed) { return true; }
+    if (length > mMaxLength) {
+        mHasOverflowed = true;
+        return true;
+    }
+    if (!available(length)) { return false; }
+    result.assign(mBuffer, mPosition, length);
+    mPosition += length;
+    return true;
+}
+
+template <typename T>
+AsyncRead<T> AsyncBinaryStreamReader::readFixed() {
+    if (mHasOverflowed) { return T{}; }
+    if (available(sizeof(T))) { return takeFixed<T>(); }
+    return waitFixed<T>();
+}
+
+template <typename T>
+AsyncTask<T> AsyncBinaryStreamReader::waitFixed() {
+    bool filled = co_await fill(sizeof(T));
+    co_return filled ? takeFixed<T>() : T{};
+}
+
+template <typename T>
+AsyncTask<T> AsyncBinaryStreamReader::waitVarInt() {
+    T value;
+    while (!tryVarInt(value)) { co_await fill(buffered() + 1); }
+    co_return value;
+}
+
+AsyncTask<bool> AsyncBinaryStreamReader::waitBytes(void* target, size_t size) {
+    bool filled = co_await fill(size);
+    if (filled) { take(target, size); }
+    co_return filled;
+}
+
+AsyncTask<std::string> AsyncBinaryStreamReader::waitString() {
+    uint32_t length;
+    while (!tryVarInt(length)) { co_await fill(buffered() + 1); }
+    co_return co_await readRawBytes(length);
+}
+
+AsyncTask<std::string> AsyncBinaryStreamReader::waitRawBytes(size_t length) {
+    std::string result;
+    bool        filled = co_await fill(length);
+    if (filled) { tryRawBytes(result, length); }
+    co_return result;
+}
+
+AsyncRead<bool> AsyncBinaryStreamReader::readBytes(void* target, size_t size) {
+    if (mHasOverflowed) { return false; }
+    if (!available(size)) { return waitBytes(target, size); }
+    take(target, size);
+    return true;
+}
+
+AsyncRead<uint8_t> AsyncBinaryStreamReader::readUnsignedChar() { return readFixed<uint8_t>(); }
+
+AsyncRead<bool> AsyncBinaryStreamReader::readBool() {
+    if (mHasOverflowed || available(1)) { return readFixed<uint8_t>().await_resume() != 0; }
+    return [](AsyncTask<uint8_t> byte) -> AsyncTask<bool> { co_return co_await byte != 0; }(waitFixed<uint8_t>());
+}
+
+AsyncRead<uint16_t> AsyncBinaryStreamReader::readUnsignedShort() { return readFixed<uint16_t>(); }
+
+AsyncRead<int16_t> AsyncBinaryStreamReader::readSignedShort() { return readFixed<int16_t>(); }
+
+AsyncRead<uint32_t> AsyncBinaryStreamReader::readUnsignedInt() { return readFixed<uint32_t>(); }
+
+AsyncRead<int32_t> AsyncBinaryStreamReader::readSignedInt() { return readFixed<int32_t>(); }
+
+AsyncRead<uint64_t> AsyncBinaryStreamReader::readUnsignedInt64() { return readFixed<uint64_t>(); }
+
+AsyncRead<int64_t> AsyncBinaryStreamReader::readSignedInt64() { return readFixed<int64_t>(); }
+
+AsyncRead<float> AsyncBinaryStreamReader::readFloat() { return readFixed<float>(); }
+
+AsyncRead<double> AsyncBinaryStreamReader::readDouble() { return readFixed<double>(); }
+
+AsyncRead<uint32_t> AsyncBinaryStreamReader::readUnsignedVarInt() {
+    uint32_t value;
+    if (tryVarInt(value)) { return value; }
+    return waitVarInt<uint32_t>();
+}
+
+AsyncRead<uint64_t> AsyncBinaryStreamReader::readUnsignedVarInt64() {
+    uint64_t value;
+    if (tryVarInt(value)) { return value; }
+    return waitVarInt<uint64_t>();
+}
+
+AsyncRead<int32_t> AsyncBinaryStreamReader::readVarInt() {
+    uint32_t value;
+    if (tryVarInt(value)) { return detail::zigzagDecode(value); }
+    return [](AsyncTask<uint32_t> raw) -> AsyncTask<int32_t> {
+        co_return detail::zigzagDecode(co_await raw);
+    }(waitVarInt<uint32_t>());
+}
+
+AsyncRead<int64_t> AsyncBinaryStreamReader::readVarInt64() {
+    uint64_t value;
+    if (tryVarInt(value)) { return detail::zigzagDecode(value); }
+    return [](AsyncTask<uint64_t> raw) -> AsyncTask<int64_t> {
+        co_return detail::zigzagDecode(co_await raw);
+    }(waitVarInt<uint64_t>());
+}
+
+AsyncRead<std::string> AsyncBinaryStreamReader::readString() {
+    uint32_t length;
+    if (!tryVarInt(length)) { return waitString(); }
+    std::string result;
+    if (tryRawBytes(result, length)) { return result; }
+    return waitRawBytes(length);
+}
+
+AsyncRead<std::string> AsyncBinaryStreamReader::readRawBytes(size_t length) {
+    std::string result;
+    if (tryRawBytes(result, length)) { return result; }
+    return waitRawBytes(length);
+}
+
+} // namespace bstream
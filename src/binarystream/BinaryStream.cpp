@@ -6,6 +6,9 @@
 // SPDX-License-Identifier: MPL-2.0
 
 #include "bstream.hpp"
+#include "detail/BitPacking.hpp"
+#include <algorithm>
+#include <cstring>
 #include <span>
 
 namespace bstream {
@@ -20,13 +23,37 @@ BinaryStream::BinaryStream(std::string& buffer, bool copyBuffer, bool bigEndian)
     mBufferView = mBuffer;
 }
 
-template <typename T>
-void BinaryStream::write(T value, bool bigEndian) {
-    if (bigEndian) { value = detail::swapEndian(value); }
-    mBuffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+BinaryStream::BinaryStream(BinaryStream const& other)
+: ReadOnlyBinaryStream(other),
+  mBuffer(&other.mBuffer == &other.mOwnedBuffer ? mOwnedBuffer : other.mBuffer) {
     mBufferView = mBuffer;
 }
 
+BinaryStream::BinaryStream(BinaryStream&& other) noexcept
+: ReadOnlyBinaryStream(std::move(other)),
+  mBuffer(&other.mBuffer == &other.mOwnedBuffer ? mOwnedBuffer : other.mBuffer) {
+    mBufferView = mBuffer;
+}
+
+// Appends through the shared BasicBinaryWriter encoders, refreshing the stream's view once the write is done
+class BinaryStream::Writer : public BasicBinaryWriter<Writer> {
+    friend class BasicBinaryWriter<Writer>;
+
+    BinaryStream& mStream;
+
+    void appendBytes(const char* data, size_t size) { mStream.mBuffer.append(data, size); }
+
+    [[nodiscard]] bool isBigEndian() const noexcept { return mStream.mBigEndian; }
+
+public:
+    explicit Writer(BinaryStream& stream) noexcept : mStream(stream) {}
+
+    Writer(Writer const&)            = delete;
+    Writer& operator=(Writer const&) = delete;
+
+    ~Writer() { mStream.mBufferView = mStream.mBuffer; }
+};
+
 void BinaryStream::reserve(size_t size) { mBuffer.reserve(size); }
 
 void BinaryStream::reset() noexcept {
@@ -48,122 +75,86 @@ std::string BinaryStream::getAndReleaseData() {
     return result;
 }
 
-void BinaryStream::writeBytes(const void* origin, size_t num) {
-    if (num > 0) {
-        mBuffer.append(reinterpret_cast<const char*>(origin), num);
-        mBufferView = mBuffer;
-    }
-}
+SharedBuffer BinaryStream::getAndReleaseSharedBuffer() { return SharedBuffer(getAndReleaseData()); }
 
-void BinaryStream::writeByte(std::byte value) { write(value, mBigEndian); }
+void BinaryStream::writeBytes(const void* origin, size_t num) { Writer(*this).writeBytes(origin, num); }
 
-void BinaryStream::writeUnsignedChar(uint8_t value) { write(value, mBigEndian); }
+void BinaryStream::writeByte(std::byte value) { Writer(*this).writeByte(value); }
 
-void BinaryStream::writeUnsignedShort(uint16_t value) { write(value, mBigEndian); }
+void BinaryStream::writeUnsignedChar(uint8_t value) { Writer(*this).writeUnsignedChar(value); }
 
-void BinaryStream::writeUnsignedInt(uint32_t value) { write(value, mBigEndian); }
+void BinaryStream::writeUnsignedShort(uint16_t value) { Writer(*this).writeUnsignedShort(value); }
 
-void BinaryStream::writeUnsignedInt64(uint64_t value) { write(value, mBigEndian); }
+void BinaryStream::writeUnsignedInt(uint32_t value) { Writer(*this).writeUnsignedInt(value); }
 
-void BinaryStream::writeBool(bool value) { write(value, mBigEndian); }
+void BinaryStream::writeUnsignedInt64(uint64_t value) { Writer(*this).writeUnsignedInt64(value); }
 
-void BinaryStream::writeDouble(double value) { write(value, mBigEndian); }
+void BinaryStream::writeBool(bool value) { Writer(*this).writeBool(value); }
 
-void BinaryStream::writeFloat(float value) { write(value, mBigEndian); }
+void BinaryStream::writeDouble(double value) { Writer(*this).writeDouble(value); }
 
-void BinaryStream::writeSignedInt(int32_t value) { write(value, mBigEndian); }
+void BinaryStream::writeFloat(float value) { Writer(*this).writeFloat(value); }
 
-void BinaryStream::writeSignedInt64(int64_t value) { write(value, mBigEndian); }
+void BinaryStream::writeSignedInt(int32_t value) { Writer(*this).writeSignedInt(value); }
 
-void BinaryStream::writeSignedShort(int16_t value) { write(value, mBigEndian); }
+void BinaryStream::writeSignedInt64(int64_t value) { Writer(*this).writeSignedInt64(value); }
 
-void BinaryStream::writeUnsignedVarInt(uint32_t uvalue) {
-    if (mBigEndian) { uvalue = detail::swapEndian(uvalue); }
-    do {
-        uint8_t next_byte   = uvalue & 0x7F;
-        uvalue            >>= 7;
-        if (uvalue != 0) { next_byte |= 0x80; }
-        writeUnsignedChar(next_byte);
-    } while (uvalue != 0);
-}
+void BinaryStream::writeSignedShort(int16_t value) { Writer(*this).writeSignedShort(value); }
 
-void BinaryStream::writeUnsignedVarInt64(uint64_t uvalue) {
-    if (mBigEndian) { uvalue = detail::swapEndian(uvalue); }
-    do {
-        uint8_t next_byte   = uvalue & 0x7F;
-        uvalue            >>= 7;
-        if (uvalue != 0) { next_byte |= 0x80; }
-        writeUnsignedChar(next_byte);
-    } while (uvalue != 0);
-}
+void BinaryStream::writeUnsignedVarInt(uint32_t uvalue) { Writer(*this).writeUnsignedVarInt(uvalue); }
 
-void BinaryStream::writeVarInt(int32_t value) {
-    if (value >= 0) {
-        writeUnsignedVarInt(static_cast<uint32_t>(value) << 1);
-    } else {
-        writeUnsignedVarInt((static_cast<uint32_t>(~value) << 1) | 1);
-    }
-}
+void BinaryStream::writeUnsignedVarInt64(uint64_t uvalue) { Writer(*this).writeUnsignedVarInt64(uvalue); }
 
-void BinaryStream::writeVarInt64(int64_t value) {
-    if (value >= 0) {
-        writeUnsignedVarInt64(static_cast<uint64_t>(value) << 1);
-    } else {
-        writeUnsignedVarInt64((static_cast<uint64_t>(~value) << 1) | 1);
-    }
-}
+void BinaryStream::writeVarInt(int32_t value) { Writer(*this).writeVarInt(value); }
 
-void BinaryStream::writeNormalizedFloat(float value) {
-    auto scaled = static_cast<int64_t>(value * 2147483647.0f);
-    writeVarInt64(scaled);
-}
+void BinaryStream::writeVarInt64(int64_t value) { Writer(*this).writeVarInt64(value); }
 
-void BinaryStream::writeSignedBigEndianInt(int32_t value) { write(value, true); }
+void BinaryStream::writeNormalizedFloat(float value) { Writer(*this).writeNormalizedFloat(value); }
 
-void BinaryStream::writeString(std::string_view value) {
-    auto size = static_cast<uint32_t>(value.size());
-    writeUnsignedVarInt(size);
-    writeRawBytes(value, static_cast<size_t>(size));
-}
+void BinaryStream::writeSignedBigEndianInt(int32_t value) { Writer(*this).writeSignedBigEndianInt(value); }
 
-void BinaryStream::writeShortString(std::string_view value) {
-    auto size = static_cast<int16_t>(value.size());
-    writeSignedShort(size);
-    writeRawBytes(value, static_cast<size_t>(size));
-}
+void BinaryStream::writeString(std::string_view value) { Writer(*this).writeString(value); }
 
-void BinaryStream::writeLongString(std::string_view value) {
-    auto size = static_cast<int>(value.size());
-    writeSignedInt(size);
-    writeRawBytes(value, static_cast<size_t>(size));
-}
+void BinaryStream::writeShortString(std::string_view value) { Writer(*this).writeShortString(value); }
 
-void BinaryStream::writeUnsignedInt24(uint32_t value) {
-    if (mBigEndian) {
-        writeUnsignedChar(static_cast<uint8_t>((value >> 16) & 0xFF));
-        writeUnsignedChar(static_cast<uint8_t>((value >> 8) & 0xFF));
-        writeUnsignedChar(static_cast<uint8_t>(value & 0xFF));
-    } else {
-        writeUnsignedChar(static_cast<uint8_t>(value & 0xFF));
-        writeUnsignedChar(static_cast<uint8_t>((value >> 8) & 0xFF));
-        writeUnsignedChar(static_cast<uint8_t>((value >> 16) & 0xFF));
-    }
-}
+void BinaryStream::writeLongString(std::string_view value) { Writer(*this).writeLongString(value); }
 
-void BinaryStream::writeRawBytes(std::string_view rawBuffer) {
-    if (!rawBuffer.empty()) {
-        mBuffer.append(rawBuffer);
-        mBufferView = mBuffer;
-    }
-}
+void BinaryStream::writeUnsignedInt24(uint32_t value) { Writer(*this).writeUnsignedInt24(value); }
+
+void BinaryStream::writeRawBytes(std::string_view rawBuffer) { Writer(*this).writeRawBytes(rawBuffer); }
 
 void BinaryStream::writeRawBytes(std::string_view rawBuffer, size_t size) {
-    if (!rawBuffer.empty()) {
-        mBuffer.append(rawBuffer.data(), size);
-        mBufferView = mBuffer;
+    Writer(*this).writeRawBytes(rawBuffer, size);
+}
+
+void BinaryStream::writeStream(ReadOnlyBinaryStream const& stream) { Writer(*this).writeStream(stream); }
+
+namespace detail {
+
+// Entries never cross a word, so the array is packed a whole number of words at a time
+bool appendPackedBitArray(ByteSink out, std::span<const uint16_t> entries, uint8_t bitsPerEntry, bool bigEndian) {
+    if (!PackedBitArray::isValidBitsPerEntry(bitsPerEntry)) { return false; }
+
+    constexpr size_t ChunkWords = 128;
+    uint8_t          words[ChunkWords * sizeof(uint32_t)];
+    size_t           chunkEntries = ChunkWords * PackedBitArray::entriesPerWord(bitsPerEntry);
+    out.reserve(PackedBitArray::wordCount(entries.size(), bitsPerEntry) * sizeof(uint32_t));
+    for (size_t offset = 0; offset < entries.size(); offset += chunkEntries) {
+        size_t count     = std::min(chunkEntries, entries.size() - offset);
+        size_t wordCount = PackedBitArray::wordCount(count, bitsPerEntry);
+        packBitArray(entries.data() + offset, count, bitsPerEntry, words);
+        if (bigEndian) { swapEndianArray(words, wordCount, sizeof(uint32_t)); }
+        out.append(words, wordCount * sizeof(uint32_t));
     }
+    return true;
 }
 
-void BinaryStream::writeStream(ReadOnlyBinaryStream const& stream) { writeRawBytes(stream.view()); }
+} // namespace detail
+
+bool BinaryStream::writePackedBitArray(std::span<const uint16_t> entries, uint8_t bitsPerEntry) {
+    bool written = detail::appendPackedBitArray(detail::ByteSink(mBuffer), entries, bitsPerEntry, mBigEndian);
+    mBufferView  = mBuffer;
+    return written;
+}
 
 } // namespace bstream
\ No newline at end of file
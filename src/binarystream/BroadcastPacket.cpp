@@ -0,0 +1,113 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "binarystream/BroadcastPacket.hpp"
+#include <algorithm>
+
+namespace bstream {
+
+PatchedPacket::PatchedPacket(SharedBuffer buffer, bool bigEndian)
+: mBuffer(std::move(buffer)),
+  mBigEndian(bigEndian) {}
+
+size_t PatchedPacket::size() const noexcept { return mBuffer.size(); }
+
+SharedBuffer const& PatchedPacket::buffer() const noexcept { return mBuffer; }
+
+std::vector<std::string_view> PatchedPacket::segments() const {
+    std::vector<std::string_view> result;
+    result.reserve(mPatches.size() * 2 + 1);
+    auto   payload = mBuffer.view();
+    size_t cursor  = 0;
+    size_t value   = 0;
+    for (auto const& patch : mPatches) {
+        if (patch.mOffset > cursor) { result.push_back(payload.substr(cursor, patch.mOffset - cursor)); }
+        if (patch.mSize > 0) { result.push_back(std::string_view(mValues).substr(value, patch.mSize)); }
+        cursor  = patch.mOffset + patch.mSize;
+        value  += patch.mSize;
+    }
+    if (cursor < payload.size()) { result.push_back(payload.substr(cursor)); }
+    return result;
+}
+
+void PatchedPacket::appendTo(std::string& out) const {
+    out.reserve(out.size() + size());
+    for (auto segment : segments()) { out.append(segment); }
+}
+
+ReadOnlyBinaryStream PatchedPacket::toStream() const {
+    std::string bytes;
+    appendTo(bytes);
+    return ReadOnlyBinaryStream(SharedBuffer(std::move(bytes)), mBigEndian);
+}
+
+BroadcastPacket::BroadcastPacket(SharedBuffer buffer, bool bigEndian)
+: mBuffer(std::move(buffer)),
+  mBigEndian(bigEndian) {}
+
+bool BroadcastPacket::addField(size_t offset, size_t size) {
+    if (offset > mBuffer.size() || size > mBuffer.size() - offset) { return false; }
+
+    // mOrder keeps the field indices sorted by offset, so the neighbours are the only possible overlaps
+    auto byOffset = [this](size_t value, size_t index) { return value < mFields[index].mOffset; };
+    auto next     = std::upper_bound(mOrder.begin(), mOrder.end(), offset, byOffset);
+    if (next != mOrder.end() && offset + size > mFields[*next].mOffset) { return false; }
+    if (next != mOrder.begin()) {
+        auto const& previous = mFields[*std::prev(next)];
+        if (previous.mOffset + previous.mSize > offset) { return false; }
+    }
+    mOrder.insert(next, mFields.size());
+    mFields.push_back({offset, size});
+    return true;
+}
+
+size_t BroadcastPacket::fieldCount() const noexcept { return mFields.size(); }
+
+SharedBuffer const& BroadcastPacket::buffer() const noexcept { return mBuffer; }
+
+ReadOnlyBinaryStream BroadcastPacket::view() const { return ReadOnlyBinaryStream(mBuffer, mBigEndian); }
+
+std::optional<PatchedPacket> BroadcastPacket::patched(std::span<const std::string_view> values) const {
+    if (values.size() != mFields.size()) { return std::nullopt; }
+    size_t total = 0;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (values[i].size() != mFields[i].mSize) { return std::nullopt; }
+        total += values[i].size();
+    }
+
+    PatchedPacket result(mBuffer, mBigEndian);
+    result.mPatches.reserve(mOrder.size());
+    result.mValues.reserve(total);
+    for (size_t index : mOrder) {
+        result.mPatches.push_back({mFields[index].mOffset, mFields[index].mSize});
+        result.mValues.append(values[index]);
+    }
+    return result;
+}
+
+SharedBuffer BroadcastCache::intern(std::string_view payload) {
+    if (auto it = mEntries.find(payload); it != mEntries.end()) { return it->second; }
+    SharedBuffer buffer(payload);
+    mEntries.emplace(buffer.view(), buffer);
+    return buffer;
+}
+
+SharedBuffer BroadcastCache::intern(BinaryStream& stream) {
+    if (auto it = mEntries.find(stream.data()); it != mEntries.end()) {
+        stream.reset();
+        return it->second;
+    }
+    SharedBuffer buffer = stream.getAndReleaseSharedBuffer();
+    mEntries.emplace(buffer.view(), buffer);
+    return buffer;
+}
+
+size_t BroadcastCache::size() const noexcept { return mEntries.size(); }
+
+void BroadcastCache::clear() noexcept { mEntries.clear(); }
+
+} // namespace bstream
@@ -0,0 +1,116 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "binarystream/ReadOnlyBinaryStream.hpp"
+#include "detail/Cpu.hpp"
+#include "detail/Simd.hpp"
+#include <cstring>
+
+#if defined(BSTREAM_CPU_X86)
+#include <tmmintrin.h>
+#endif
+
+namespace bstream::detail {
+
+namespace {
+
+using SwapKernel = void (*)(uint8_t*, size_t, size_t) noexcept;
+
+template <typename T>
+void swapScalar(uint8_t* data, size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        T value;
+        std::memcpy(&value, data + i * sizeof(T), sizeof(T));
+        value = swapEndian(value);
+        std::memcpy(data + i * sizeof(T), &value, sizeof(T));
+    }
+}
+
+void swapElementsScalar(uint8_t* data, size_t count, size_t elementSize) noexcept {
+    switch (elementSize) {
+    case 2:
+        swapScalar<uint16_t>(data, count);
+        break;
+    case 4:
+        swapScalar<uint32_t>(data, count);
+        break;
+    case 8:
+        swapScalar<uint64_t>(data, count);
+        break;
+    default:
+        break;
+    }
+}
+
+#if defined(BSTREAM_CPU_X86)
+BSTREAM_TARGET("ssse3")
+void swapElementsSsse3(uint8_t* data, size_t count, size_t elementSize) noexcept {
+    __m128i mask;
+    switch (elementSize) {
+    case 2:
+        mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+        break;
+    case 4:
+        mask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        break;
+    case 8:
+        mask = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        break;
+    default:
+        return;
+    }
+    size_t length = count * elementSize;
+    size_t offset = 0;
+    for (; offset + 16 <= length; offset += 16) {
+        auto    block = reinterpret_cast<__m128i*>(data + offset);
+        __m128i value = _mm_loadu_si128(block);
+        _mm_storeu_si128(block, _mm_shuffle_epi8(value, mask));
+    }
+    swapElementsScalar(data + offset, (length - offset) / elementSize, elementSize);
+}
+#elif defined(BSTREAM_SIMD_NEON)
+void swapElementsNeon(uint8_t* data, size_t count, size_t elementSize) noexcept {
+    size_t length = count * elementSize;
+    size_t offset = 0;
+    for (; offset + 16 <= length; offset += 16) {
+        uint8x16_t value = vld1q_u8(data + offset);
+        switch (elementSize) {
+        case 2:
+            value = vrev16q_u8(value);
+            break;
+        case 4:
+            value = vrev32q_u8(value);
+            break;
+        case 8:
+            value = vrev64q_u8(value);
+            break;
+        default:
+            return;
+        }
+        vst1q_u8(data + offset, value);
+    }
+    swapElementsScalar(data + offset, (length - offset) / elementSize, elementSize);
+}
+#endif
+
+SwapKernel selectSwapKernel() noexcept {
+#if defined(BSTREAM_CPU_X86)
+    if (cpu::hasSsse3()) { return &swapElementsSsse3; }
+#elif defined(BSTREAM_SIMD_NEON)
+    return &swapElementsNeon;
+#endif
+    return &swapElementsScalar;
+}
+
+} // namespace
+
+void swapEndianArray(void* data, size_t count, size_t elementSize) noexcept {
+    static const SwapKernel kernel = selectSwapKernel();
+    if (elementSize > 1 && count > 0) { kernel(static_cast<uint8_t*>(data), count, elementSize); }
+}
+
+} // namespace bstream::detail
@@ -0,0 +1,171 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "binarystream/Checksum.hpp"
+#include "detail/Cpu.hpp"
+#include <array>
+#include <cstring>
+
+#if defined(BSTREAM_CPU_X86)
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+namespace bstream {
+
+namespace {
+
+using CrcKernel = uint32_t (*)(uint32_t, const uint8_t*, size_t) noexcept;
+
+constexpr uint32_t Crc32cPolynomial = 0x82F63B78;
+
+constexpr std::array<std::array<uint32_t, 256>, 8> makeCrcTables() noexcept {
+    std::array<std::array<uint32_t, 256>, 8> tables{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) { crc = (crc >> 1) ^ ((crc & 1) ? Crc32cPolynomial : 0); }
+        tables[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; ++i) {
+        for (size_t t = 1; t < 8; ++t) { tables[t][i] = (tables[t - 1][i] >> 8) ^ tables[0][tables[t - 1][i] & 0xFF]; }
+    }
+    return tables;
+}
+
+constexpr auto CrcTables = makeCrcTables();
+
+// Slicing-by-8
+uint32_t crc32cSoftware(uint32_t crc, const uint8_t* data, size_t size) noexcept {
+    while (size >= 8) {
+        uint32_t low, high;
+        std::memcpy(&low, data, sizeof(low));
+        std::memcpy(&high, data + 4, sizeof(high));
+        low  ^= crc;
+        crc   = CrcTables[7][low & 0xFF] ^ CrcTables[6][(low >> 8) & 0xFF] ^ CrcTables[5][(low >> 16) & 0xFF]
+            ^ CrcTables[4][low >> 24] ^ CrcTables[3][high & 0xFF] ^ CrcTables[2][(high >> 8) & 0xFF]
+            ^ CrcTables[1][(high >> 16) & 0xFF] ^ CrcTables[0][high >> 24];
+        data += 8;
+        size -= 8;
+    }
+    while (size-- > 0) { crc = (crc >> 8) ^ CrcTables[0][(crc ^ *data++) & 0xFF]; }
+    return crc;
+}
+
+#if defined(BSTREAM_CPU_X86)
+BSTREAM_TARGET("sse4.2")
+uint32_t crc32cSse42(uint32_t crc, const uint8_t* data, size_t size) noexcept {
+#if defined(__x86_64__) || defined(_M_X64)
+    uint64_t crc64 = crc;
+    while (size >= 8) {
+        uint64_t value;
+        std::memcpy(&value, data, sizeof(value));
+        crc64  = _mm_crc32_u64(crc64, value);
+        data  += 8;
+        size  -= 8;
+    }
+    crc = static_cast<uint32_t>(crc64);
+#endif
+    while (size >= 4) {
+        uint32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        crc   = _mm_crc32_u32(crc, value);
+        data += 4;
+        size -= 4;
+    }
+    while (size-- > 0) { crc = _mm_crc32_u8(crc, *data++); }
+    return crc;
+}
+#elif defined(__ARM_FEATURE_CRC32)
+uint32_t crc32cArm(uint32_t crc, const uint8_t* data, size_t size) noexcept {
+    while (size >= 8) {
+        uint64_t value;
+        std::memcpy(&value, data, sizeof(value));
+        crc   = __crc32cd(crc, value);
+        data += 8;
+        size -= 8;
+    }
+    while (size-- > 0) { crc = __crc32cb(crc, *data++); }
+    return crc;
+}
+#endif
+
+CrcKernel selectCrcKernel() noexcept {
+#if defined(BSTREAM_CPU_X86)
+    if (detail::cpu::hasSse42()) { return &crc32cSse42; }
+#elif defined(__ARM_FEATURE_CRC32)
+    return &crc32cArm;
+#endif
+    return &crc32cSoftware;
+}
+
+} // namespace
+
+void Crc32c::update(const void* data, size_t size) noexcept {
+    static const CrcKernel kernel = selectCrcKernel();
+    if (size > 0) { mState = kernel(mState, static_cast<const uint8_t*>(data), size); }
+}
+
+uint32_t Crc32c::compute(std::string_view data) noexcept {
+    Crc32c crc;
+    crc.update(data);
+    return crc.digest();
+}
+
+ChecksumTracker::ChecksumTracker(ReadOnlyBinaryStream const& stream) noexcept
+: mStream(&stream),
+  mTracksWrites(false),
+  mRegionStart(0),
+  mPosition(0) {
+    mark();
+}
+
+ChecksumTracker::ChecksumTracker(BinaryStream const& stream) noexcept
+: mStream(&stream),
+  mTracksWrites(true),
+  mRegionStart(0),
+  mPosition(0) {
+    mark();
+}
+
+size_t ChecksumTracker::currentPosition() const noexcept {
+    size_t size = mStream->size();
+    if (mTracksWrites) { return size; }
+    return std::min(mStream->getPosition(), size);
+}
+
+void ChecksumTracker::mark() noexcept {
+    mRegionStart = currentPosition();
+    mPosition    = mRegionStart;
+    mCrc.reset();
+}
+
+uint32_t ChecksumTracker::update() noexcept {
+    size_t position = currentPosition();
+    if (position < mPosition) {
+        // The stream was reset or rewound, so some hashed bytes are gone; the old region cannot be trusted
+        mRegionStart = position;
+        mPosition    = position;
+        mCrc.reset();
+    } else if (position > mPosition) {
+        mCrc.update(mStream->view().substr(mPosition, position - mPosition));
+        mPosition = position;
+    }
+    return mCrc.digest();
+}
+
+uint32_t ChecksumTracker::finalize() noexcept {
+    uint32_t digest = update();
+    mark();
+    return digest;
+}
+
+size_t ChecksumTracker::regionStart() const noexcept { return mRegionStart; }
+
+size_t ChecksumTracker::regionSize() const noexcept { return mPosition - mRegionStart; }
+
+} // namespace bstream
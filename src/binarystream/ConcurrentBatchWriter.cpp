@@ -0,0 +1,114 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "binarystream/ConcurrentBatchWriter.hpp"
+#include <limits>
+
+namespace bstream {
+
+ConcurrentBatchWriter::Block::Block(size_t capacity)
+: mData(capacity, '\0'),
+  mUsed(0),
+  mEnd(std::numeric_limits<size_t>::max()) {}
+
+size_t ConcurrentBatchWriter::Block::size() const noexcept {
+    return std::min(mUsed.load(std::memory_order_relaxed), mEnd.load(std::memory_order_relaxed));
+}
+
+void ConcurrentBatchWriter::Block::clear() noexcept {
+    mUsed.store(0, std::memory_order_relaxed);
+    mEnd.store(std::numeric_limits<size_t>::max(), std::memory_order_relaxed);
+}
+
+ConcurrentBatchWriter::ConcurrentBatchWriter(size_t blockSize, bool bigEndian)
+: mCurrentIndex(0),
+  mPending(0),
+  mHasFailed(false),
+  mBlockSize(std::max<size_t>(blockSize, 1)),
+  mBigEndian(bigEndian) {
+    mBlocks.push_back(std::make_unique<Block>(mBlockSize));
+    mCurrent.store(mBlocks.back().get(), std::memory_order_release);
+}
+
+SpanBinaryStream ConcurrentBatchWriter::reserve(size_t size) {
+    while (true) {
+        Block* block  = mCurrent.load(std::memory_order_acquire);
+        size_t offset = block->mUsed.fetch_add(size, std::memory_order_relaxed);
+        if (offset <= block->mData.size() && size <= block->mData.size() - offset) {
+            mPending.fetch_add(1, std::memory_order_relaxed);
+            return SpanBinaryStream(block->mData.data() + offset, size, mBigEndian);
+        }
+
+        size_t end = block->mEnd.load(std::memory_order_relaxed);
+        while (offset < end && !block->mEnd.compare_exchange_weak(end, offset, std::memory_order_relaxed)) {}
+        grow(block, size);
+    }
+}
+
+bool ConcurrentBatchWriter::commit(SpanBinaryStream const& packet) noexcept {
+    bool complete = !packet.isOverflowed() && packet.size() == packet.capacity();
+    if (!complete) { mHasFailed.store(true, std::memory_order_relaxed); }
+    mPending.fetch_sub(1, std::memory_order_release);
+    return complete;
+}
+
+// Moves on to the next kept block if it can hold size bytes, otherwise inserts a new one after the full block
+void ConcurrentBatchWriter::grow(Block* full, size_t size) {
+    std::lock_guard lock(mGrowMutex);
+    if (mCurrent.load(std::memory_order_relaxed) != full) { return; }
+    size_t next = mCurrentIndex + 1;
+    if (next == mBlocks.size() || mBlocks[next]->mData.size() < size) {
+        auto block = std::make_unique<Block>(std::max(mBlockSize, size));
+        mBlocks.insert(mBlocks.begin() + static_cast<ptrdiff_t>(next), std::move(block));
+    }
+    mCurrentIndex = next;
+    mCurrent.store(mBlocks[next].get(), std::memory_order_release);
+}
+
+size_t ConcurrentBatchWriter::size() const noexcept {
+    size_t total = 0;
+    for (auto const& block : mBlocks) { total += block->size(); }
+    return total;
+}
+
+std::vector<std::string_view> ConcurrentBatchWriter::segments() const {
+    std::vector<std::string_view> result;
+    result.reserve(mBlocks.size());
+    for (auto const& block : mBlocks) {
+        if (size_t used = block->size(); used > 0) { result.emplace_back(block->mData.data(), used); }
+    }
+    return result;
+}
+
+bool ConcurrentBatchWriter::seal(std::string& batch) {
+    bool complete = mPending.load(std::memory_order_acquire) == 0 && !mHasFailed.load(std::memory_order_relaxed);
+    batch.clear();
+    if (complete) {
+        auto& first = *mBlocks.front();
+        if (size_t used = first.size(); mCurrentIndex == 0) {
+            size_t capacity = first.mData.size();
+            batch.swap(first.mData);
+            batch.resize(used);
+            first.mData.resize(capacity);
+        } else {
+            batch.reserve(size());
+            for (auto segment : segments()) { batch.append(segment); }
+        }
+    }
+    reset();
+    return complete;
+}
+
+void ConcurrentBatchWriter::reset() noexcept {
+    for (auto& block : mBlocks) { block->clear(); }
+    mCurrentIndex = 0;
+    mPending.store(0, std::memory_order_relaxed);
+    mHasFailed.store(false, std::memory_order_relaxed);
+    mCurrent.store(mBlocks.front().get(), std::memory_order_release);
+}
+
+} // namespace bstream
@@ -0,0 +1,376 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "binarystream/PackedBitArray.hpp"
+#include "detail/BitPacking.hpp"
+#include "detail/Cpu.hpp"
+#include "detail/Simd.hpp"
+#include <array>
+#include <cstring>
+#include <numeric>
+#include <utility>
+
+#if defined(BSTREAM_CPU_X86)
+#include <tmmintrin.h>
+#endif
+
+namespace bstream {
+
+namespace detail {
+
+namespace {
+
+inline uint32_t loadWord(const uint8_t* data) noexcept {
+    uint32_t word;
+    std::memcpy(&word, data, sizeof(word));
+    return word;
+}
+
+inline void storeWord(uint8_t* data, uint32_t word) noexcept { std::memcpy(data, &word, sizeof(word)); }
+
+template <unsigned Bits>
+void unpackScalar(const uint8_t* words, uint16_t* entries, size_t count) noexcept {
+    constexpr size_t   PerWord = 32 / Bits;
+    constexpr uint32_t Mask    = (1u << Bits) - 1;
+
+    size_t fullWords = count / PerWord;
+    for (size_t w = 0; w < fullWords; ++w) {
+        uint32_t word = loadWord(words + w * 4);
+        for (size_t j = 0; j < PerWord; ++j) {
+            entries[w * PerWord + j] = static_cast<uint16_t>((word >> (j * Bits)) & Mask);
+        }
+    }
+    size_t rest = count - fullWords * PerWord;
+    if (rest > 0) {
+        uint32_t word = loadWord(words + fullWords * 4);
+        for (size_t j = 0; j < rest; ++j) {
+            entries[fullWords * PerWord + j] = static_cast<uint16_t>((word >> (j * Bits)) & Mask);
+        }
+    }
+}
+
+template <unsigned Bits>
+void packScalar(const uint16_t* entries, size_t count, uint8_t* words) noexcept {
+    constexpr size_t   PerWord = 32 / Bits;
+    constexpr uint32_t Mask    = (1u << Bits) - 1;
+
+    size_t fullWords = count / PerWord;
+    for (size_t w = 0; w < fullWords; ++w) {
+        uint32_t word = 0;
+        for (size_t j = 0; j < PerWord; ++j) {
+            word |= (static_cast<uint32_t>(entries[w * PerWord + j]) & Mask) << (j * Bits);
+        }
+        storeWord(words + w * 4, word);
+    }
+    size_t rest = count - fullWords * PerWord;
+    if (rest > 0) {
+        uint32_t word = 0;
+        for (size_t j = 0; j < rest; ++j) {
+            word |= (static_cast<uint32_t>(entries[fullWords * PerWord + j]) & Mask) << (j * Bits);
+        }
+        storeWord(words + fullWords * 4, word);
+    }
+}
+
+// Power-of-two widths up to 8 never leave padding bits, so on a little-endian host the words form one contiguous bit
+// stream and a 16-byte block can be expanded or narrowed with byte-level interleaving.
+template <unsigned Bits>
+constexpr bool HasBlockKernel = Bits == 1 || Bits == 2 || Bits == 4 || Bits == 8;
+
+#if defined(BSTREAM_SIMD_SSE2)
+
+template <unsigned Bits>
+void unpackBlock(const uint8_t* words, uint16_t* entries) noexcept {
+    constexpr size_t Count = 8 / Bits;
+
+    __m128i groups[Count];
+    groups[0]    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words));
+    size_t count = 1;
+    for (unsigned width = 8; width > Bits; width /= 2) {
+        unsigned half  = width / 2;
+        __m128i  mask  = _mm_set1_epi8(static_cast<char>((1u << half) - 1));
+        __m128i  shift = _mm_cvtsi32_si128(static_cast<int>(half));
+        for (size_t i = count; i-- > 0;) {
+            __m128i low       = _mm_and_si128(groups[i], mask);
+            __m128i high      = _mm_and_si128(_mm_srl_epi16(groups[i], shift), mask);
+            groups[2 * i]     = _mm_unpacklo_epi8(low, high);
+            groups[2 * i + 1] = _mm_unpackhi_epi8(low, high);
+        }
+        count *= 2;
+    }
+    __m128i zero = _mm_setzero_si128();
+    for (size_t i = 0; i < Count; ++i) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(entries + i * 16), _mm_unpacklo_epi8(groups[i], zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(entries + i * 16 + 8), _mm_unpackhi_epi8(groups[i], zero));
+    }
+}
+
+template <unsigned Bits>
+void packBlock(const uint16_t* entries, uint8_t* words) noexcept {
+    constexpr size_t Count = 8 / Bits;
+
+    __m128i groups[Count];
+    __m128i entryMask = _mm_set1_epi16(static_cast<short>((1u << Bits) - 1));
+    for (size_t i = 0; i < Count; ++i) {
+        auto    source = reinterpret_cast<const __m128i*>(entries + i * 16);
+        __m128i low    = _mm_and_si128(_mm_loadu_si128(source), entryMask);
+        __m128i high   = _mm_and_si128(_mm_loadu_si128(source + 1), entryMask);
+        groups[i]      = _mm_packus_epi16(low, high);
+    }
+    size_t  count   = Count;
+    __m128i lowByte = _mm_set1_epi16(0xFF);
+    for (unsigned width = Bits; width < 8; width *= 2) {
+        __m128i shift = _mm_cvtsi32_si128(static_cast<int>(width));
+        for (size_t i = 0; i < count / 2; ++i) {
+            __m128i first  = groups[2 * i];
+            __m128i second = groups[2 * i + 1];
+            first  = _mm_or_si128(_mm_and_si128(first, lowByte), _mm_sll_epi16(_mm_srli_epi16(first, 8), shift));
+            second = _mm_or_si128(_mm_and_si128(second, lowByte), _mm_sll_epi16(_mm_srli_epi16(second, 8), shift));
+            groups[i] = _mm_packus_epi16(first, second);
+        }
+        count /= 2;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(words), groups[0]);
+}
+
+#elif defined(BSTREAM_SIMD_NEON)
+
+template <unsigned Bits>
+void unpackBlock(const uint8_t* words, uint16_t* entries) noexcept {
+    constexpr size_t Count = 8 / Bits;
+
+    uint8x16_t groups[Count];
+    groups[0]    = vld1q_u8(words);
+    size_t count = 1;
+    for (unsigned width = 8; width > Bits; width /= 2) {
+        unsigned   half  = width / 2;
+        uint8x16_t mask  = vdupq_n_u8(static_cast<uint8_t>((1u << half) - 1));
+        int8x16_t  shift = vdupq_n_s8(static_cast<int8_t>(-static_cast<int>(half)));
+        for (size_t i = count; i-- > 0;) {
+            uint8x16_t low    = vandq_u8(groups[i], mask);
+            uint8x16_t high   = vandq_u8(vshlq_u8(groups[i], shift), mask);
+            groups[2 * i]     = vzip1q_u8(low, high);
+            groups[2 * i + 1] = vzip2q_u8(low, high);
+        }
+        count *= 2;
+    }
+    for (size_t i = 0; i < Count; ++i) {
+        vst1q_u16(entries + i * 16, vmovl_u8(vget_low_u8(groups[i])));
+        vst1q_u16(entries + i * 16 + 8, vmovl_high_u8(groups[i]));
+    }
+}
+
+template <unsigned Bits>
+void packBlock(const uint16_t* entries, uint8_t* words) noexcept {
+    constexpr size_t Count = 8 / Bits;
+
+    uint8x16_t groups[Count];
+    uint16x8_t entryMask = vdupq_n_u16(static_cast<uint16_t>((1u << Bits) - 1));
+    for (size_t i = 0; i < Count; ++i) {
+        uint16x8_t low  = vandq_u16(vld1q_u16(entries + i * 16), entryMask);
+        uint16x8_t high = vandq_u16(vld1q_u16(entries + i * 16 + 8), entryMask);
+        groups[i]       = vcombine_u8(vmovn_u16(low), vmovn_u16(high));
+    }
+    size_t     count   = Count;
+    uint16x8_t lowByte = vdupq_n_u16(0xFF);
+    for (unsigned width = Bits; width < 8; width *= 2) {
+        int16x8_t shift = vdupq_n_s16(static_cast<int16_t>(width));
+        for (size_t i = 0; i < count / 2; ++i) {
+            uint16x8_t first  = vreinterpretq_u16_u8(groups[2 * i]);
+            uint16x8_t second = vreinterpretq_u16_u8(groups[2 * i + 1]);
+            first     = vorrq_u16(vandq_u16(first, lowByte), vshlq_u16(vshrq_n_u16(first, 8), shift));
+            second    = vorrq_u16(vandq_u16(second, lowByte), vshlq_u16(vshrq_n_u16(second, 8), shift));
+            groups[i] = vcombine_u8(vmovn_u16(first), vmovn_u16(second));
+        }
+        count /= 2;
+    }
+    vst1q_u8(words, groups[0]);
+}
+
+#endif
+
+// The other widths up to 9 leave padding bits at the top of each word, but no entry spans more than two bytes: every 8
+// entries are gathered into 16-bit lanes with one byte shuffle, moved to the top of the lane by a multiply and shifted
+// back down by the width. The shuffle pattern repeats every lcm(8, entries per word) entries. Wider entries, and
+// packing at any width other than 1, 2, 4 or 8, stay scalar.
+template <unsigned Bits>
+constexpr bool HasShuffleKernel = Bits >= 3 && Bits <= 9 && !HasBlockKernel<Bits>;
+
+template <unsigned Bits>
+struct ShuffleLayout {
+    static constexpr size_t PerWord       = 32 / Bits;
+    static constexpr size_t PeriodChunks  = std::lcm(size_t(8), PerWord) / 8;
+    static constexpr size_t PeriodEntries = PeriodChunks * 8;
+    static constexpr size_t PeriodWords   = PeriodEntries / PerWord;
+
+    uint8_t  mShuffle[PeriodChunks][16];
+    uint16_t mMultiplier[PeriodChunks][8];
+    size_t   mFirstWord[PeriodChunks];
+};
+
+template <unsigned Bits>
+constexpr ShuffleLayout<Bits> makeShuffleLayout() {
+    using Layout = ShuffleLayout<Bits>;
+
+    Layout layout{};
+    for (size_t chunk = 0; chunk < Layout::PeriodChunks; ++chunk) {
+        size_t first             = chunk * 8 / Layout::PerWord;
+        layout.mFirstWord[chunk] = first;
+        for (size_t lane = 0; lane < 8; ++lane) {
+            size_t entry = chunk * 8 + lane;
+            size_t bit   = (entry / Layout::PerWord - first) * 32 + (entry % Layout::PerWord) * Bits;
+            size_t byte  = bit / 8;
+            layout.mShuffle[chunk][2 * lane]     = static_cast<uint8_t>(byte);
+            layout.mShuffle[chunk][2 * lane + 1] = byte + 1 < 16 ? static_cast<uint8_t>(byte + 1) : 0x80;
+            layout.mMultiplier[chunk][lane]      = static_cast<uint16_t>(1u << (16 - bit % 8 - Bits));
+        }
+    }
+    return layout;
+}
+
+template <unsigned Bits>
+constexpr ShuffleLayout<Bits> ShuffleLayouts = makeShuffleLayout<Bits>();
+
+using PeriodKernel = void (*)(const uint8_t* words, uint16_t* entries) noexcept;
+
+#if defined(BSTREAM_CPU_X86)
+template <unsigned Bits>
+BSTREAM_TARGET("ssse3")
+void unpackPeriodSsse3(const uint8_t* words, uint16_t* entries) noexcept {
+    constexpr auto& Layout = ShuffleLayouts<Bits>;
+    for (size_t chunk = 0; chunk < ShuffleLayout<Bits>::PeriodChunks; ++chunk) {
+        auto    source = reinterpret_cast<const __m128i*>(words + Layout.mFirstWord[chunk] * 4);
+        __m128i mask   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Layout.mShuffle[chunk]));
+        __m128i scale  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Layout.mMultiplier[chunk]));
+        __m128i value  = _mm_mullo_epi16(_mm_shuffle_epi8(_mm_loadu_si128(source), mask), scale);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(entries + chunk * 8), _mm_srli_epi16(value, 16 - Bits));
+    }
+}
+#elif defined(BSTREAM_SIMD_NEON)
+template <unsigned Bits>
+void unpackPeriodNeon(const uint8_t* words, uint16_t* entries) noexcept {
+    constexpr auto& Layout = ShuffleLayouts<Bits>;
+    for (size_t chunk = 0; chunk < ShuffleLayout<Bits>::PeriodChunks; ++chunk) {
+        uint8x16_t data  = vld1q_u8(words + Layout.mFirstWord[chunk] * 4);
+        uint8x16_t bytes = vqtbl1q_u8(data, vld1q_u8(Layout.mShuffle[chunk]));
+        uint16x8_t value = vmulq_u16(vreinterpretq_u16_u8(bytes), vld1q_u16(Layout.mMultiplier[chunk]));
+        vst1q_u16(entries + chunk * 8, vshrq_n_u16(value, 16 - Bits));
+    }
+}
+#endif
+
+template <unsigned Bits>
+PeriodKernel selectPeriodKernel() noexcept {
+#if defined(BSTREAM_CPU_X86)
+    if (cpu::hasSsse3()) { return &unpackPeriodSsse3<Bits>; }
+#elif defined(BSTREAM_SIMD_NEON)
+    return &unpackPeriodNeon<Bits>;
+#endif
+    return nullptr;
+}
+
+// Returns the number of entries decoded, always a whole number of words; every 16-byte load stays inside the words
+template <unsigned Bits>
+size_t unpackShuffled(const uint8_t* words, uint16_t* entries, size_t count) noexcept {
+    using Layout = ShuffleLayout<Bits>;
+    static const PeriodKernel kernel = selectPeriodKernel<Bits>();
+    if (kernel == nullptr) { return 0; }
+
+    size_t totalWords = (count + Layout::PerWord - 1) / Layout::PerWord;
+    size_t lastLoad   = ShuffleLayouts<Bits>.mFirstWord[Layout::PeriodChunks - 1] + 4;
+    size_t periods    = count / Layout::PeriodEntries;
+    while (periods > 0 && (periods - 1) * Layout::PeriodWords + lastLoad > totalWords) { --periods; }
+    for (size_t p = 0; p < periods; ++p) {
+        kernel(words + p * Layout::PeriodWords * 4, entries + p * Layout::PeriodEntries);
+    }
+    return periods * Layout::PeriodEntries;
+}
+
+template <unsigned Bits>
+void unpackEntries(const uint8_t* words, uint16_t* entries, size_t count) noexcept {
+#if defined(BSTREAM_SIMD_SSE2) || defined(BSTREAM_SIMD_NEON)
+    if constexpr (HasBlockKernel<Bits>) {
+        constexpr size_t PerBlock = 128 / Bits;
+        size_t           blocks   = count / PerBlock;
+        for (size_t b = 0; b < blocks; ++b) { unpackBlock<Bits>(words + b * 16, entries + b * PerBlock); }
+        words   += blocks * 16;
+        entries += blocks * PerBlock;
+        count   -= blocks * PerBlock;
+    }
+#endif
+#if defined(BSTREAM_CPU_X86) || defined(BSTREAM_SIMD_NEON)
+    if constexpr (HasShuffleKernel<Bits>) {
+        size_t decoded  = unpackShuffled<Bits>(words, entries, count);
+        words          += decoded / ShuffleLayout<Bits>::PerWord * 4;
+        entries        += decoded;
+        count          -= decoded;
+    }
+#endif
+    unpackScalar<Bits>(words, entries, count);
+}
+
+template <unsigned Bits>
+void packEntries(const uint16_t* entries, size_t count, uint8_t* words) noexcept {
+#if defined(BSTREAM_SIMD_SSE2) || defined(BSTREAM_SIMD_NEON)
+    if constexpr (HasBlockKernel<Bits>) {
+        constexpr size_t PerBlock = 128 / Bits;
+        size_t           blocks   = count / PerBlock;
+        for (size_t b = 0; b < blocks; ++b) { packBlock<Bits>(entries + b * PerBlock, words + b * 16); }
+        words   += blocks * 16;
+        entries += blocks * PerBlock;
+        count   -= blocks * PerBlock;
+    }
+#endif
+    packScalar<Bits>(entries, count, words);
+}
+
+using UnpackKernel = void (*)(const uint8_t*, uint16_t*, size_t) noexcept;
+using PackKernel   = void (*)(const uint16_t*, size_t, uint8_t*) noexcept;
+
+template <size_t... I>
+constexpr std::array<UnpackKernel, sizeof...(I)> makeUnpackKernels(std::index_sequence<I...>) noexcept {
+    return {&unpackEntries<I + 1>...};
+}
+
+template <size_t... I>
+constexpr std::array<PackKernel, sizeof...(I)> makePackKernels(std::index_sequence<I...>) noexcept {
+    return {&packEntries<I + 1>...};
+}
+
+constexpr auto UnpackKernels = makeUnpackKernels(std::make_index_sequence<PackedBitArray::MaxBitsPerEntry>());
+constexpr auto PackKernels   = makePackKernels(std::make_index_sequence<PackedBitArray::MaxBitsPerEntry>());
+
+} // namespace
+
+void packBitArray(const uint16_t* entries, size_t entryCount, uint8_t bitsPerEntry, uint8_t* words) noexcept {
+    PackKernels[bitsPerEntry - 1](entries, entryCount, words);
+}
+
+void unpackBitArray(const uint8_t* words, uint8_t bitsPerEntry, uint16_t* entries, size_t entryCount) noexcept {
+    UnpackKernels[bitsPerEntry - 1](words, entries, entryCount);
+}
+
+} // namespace detail
+
+bool PackedBitArray::pack(std::span<const uint16_t> entries, uint8_t bitsPerEntry, std::span<uint32_t> words) noexcept {
+    if (!isValidBitsPerEntry(bitsPerEntry) || words.size() < wordCount(entries.size(), bitsPerEntry)) { return false; }
+    detail::packBitArray(entries.data(), entries.size(), bitsPerEntry, reinterpret_cast<uint8_t*>(words.data()));
+    return true;
+}
+
+bool PackedBitArray::unpack(
+    std::span<const uint32_t> words,
+    uint8_t                   bitsPerEntry,
+    std::span<uint16_t>       entries
+) noexcept {
+    if (!isValidBitsPerEntry(bitsPerEntry) || words.size() < wordCount(entries.size(), bitsPerEntry)) { return false; }
+    auto source = reinterpret_cast<const uint8_t*>(words.data());
+    detail::unpackBitArray(source, bitsPerEntry, entries.data(), entries.size());
+    return true;
+}
+
+} // namespace bstream
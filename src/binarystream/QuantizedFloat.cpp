@@ -0,0 +1,384 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "binarystream/BasicBinaryWriter.hpp"
+#include "binarystream/BinaryStream.hpp"
+#include "binarystream/SizeMeasuringStream.hpp"
+#include "binarystream/detail/VarInt.hpp"
+#include "detail/Cpu.hpp"
+#include "detail/Simd.hpp"
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(BSTREAM_CPU_X86)
+#include <immintrin.h>
+#endif
+
+namespace bstream {
+
+namespace {
+
+constexpr size_t ChunkSize = 64;
+
+// IEEE 754 binary16 conversion with round-to-nearest-even, matching F16C and NEON
+uint16_t floatToHalf(float value) noexcept {
+    uint32_t bits      = std::bit_cast<uint32_t>(value);
+    auto     sign      = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    uint32_t magnitude = bits & 0x7FFFFFFF;
+
+    if (magnitude >= 0x7F800000) {
+        uint32_t payload = magnitude > 0x7F800000 ? 0x200 | ((magnitude >> 13) & 0x3FF) : 0;
+        return static_cast<uint16_t>(sign | 0x7C00 | payload);
+    }
+    if (magnitude >= 0x477FF000) { return static_cast<uint16_t>(sign | 0x7C00); }
+    if (magnitude < 0x38800000) {
+        if (magnitude <= 0x33000000) { return sign; }
+        uint32_t exponent = magnitude >> 23;
+        uint32_t mantissa = (magnitude & 0x7FFFFF) | 0x800000;
+        uint32_t shift    = 126 - exponent;
+        uint32_t result   = mantissa >> shift;
+        uint32_t rest     = mantissa & ((1u << shift) - 1);
+        uint32_t halfway  = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (result & 1))) { ++result; }
+        return static_cast<uint16_t>(sign | result);
+    }
+    uint32_t result = (magnitude - 0x38000000) >> 13;
+    uint32_t rest   = magnitude & 0x1FFF;
+    if (rest > 0x1000 || (rest == 0x1000 && (result & 1))) { ++result; }
+    return static_cast<uint16_t>(sign | result);
+}
+
+float halfToFloat(uint16_t value) noexcept {
+    uint32_t sign     = static_cast<uint32_t>(value & 0x8000) << 16;
+    uint32_t exponent = (value >> 10) & 0x1F;
+    uint32_t mantissa = value & 0x3FF;
+
+    if (exponent == 0) {
+        float magnitude = static_cast<float>(mantissa) * 0x1p-24f;
+        return sign ? -magnitude : magnitude;
+    }
+    if (exponent == 31) { return std::bit_cast<float>(sign | 0x7F800000 | (mantissa << 13)); }
+    return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+void floatsToHalfScalar(const float* values, uint8_t* out, size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        uint16_t half = floatToHalf(values[i]);
+        std::memcpy(out + i * 2, &half, sizeof(half));
+    }
+}
+
+void halfToFloatsScalar(const uint8_t* data, float* values, size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        uint16_t half;
+        std::memcpy(&half, data + i * 2, sizeof(half));
+        values[i] = halfToFloat(half);
+    }
+}
+
+#if defined(BSTREAM_CPU_X86)
+BSTREAM_TARGET("avx,f16c")
+void floatsToHalfF16c(const float* values, uint8_t* out, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(values + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2), half);
+    }
+    floatsToHalfScalar(values + i, out + i * 2, count - i);
+}
+
+BSTREAM_TARGET("avx,f16c")
+void halfToFloatsF16c(const uint8_t* data, float* values, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 2));
+        _mm256_storeu_ps(values + i, _mm256_cvtph_ps(half));
+    }
+    halfToFloatsScalar(data + i * 2, values + i, count - i);
+}
+#elif defined(BSTREAM_SIMD_NEON)
+void floatsToHalfNeon(const float* values, uint8_t* out, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float16x4_t half = vcvt_f16_f32(vld1q_f32(values + i));
+        vst1_u8(out + i * 2, vreinterpret_u8_f16(half));
+    }
+    floatsToHalfScalar(values + i, out + i * 2, count - i);
+}
+
+void halfToFloatsNeon(const uint8_t* data, float* values, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float16x4_t half = vreinterpret_f16_u8(vld1_u8(data + i * 2));
+        vst1q_f32(values + i, vcvt_f32_f16(half));
+    }
+    halfToFloatsScalar(data + i * 2, values + i, count - i);
+}
+#endif
+
+using ToHalfKernel   = void (*)(const float*, uint8_t*, size_t) noexcept;
+using FromHalfKernel = void (*)(const uint8_t*, float*, size_t) noexcept;
+
+ToHalfKernel selectToHalfKernel() noexcept {
+#if defined(BSTREAM_CPU_X86)
+    if (detail::cpu::hasF16c()) { return &floatsToHalfF16c; }
+#elif defined(BSTREAM_SIMD_NEON)
+    return &floatsToHalfNeon;
+#endif
+    return &floatsToHalfScalar;
+}
+
+FromHalfKernel selectFromHalfKernel() noexcept {
+#if defined(BSTREAM_CPU_X86)
+    if (detail::cpu::hasF16c()) { return &halfToFloatsF16c; }
+#elif defined(BSTREAM_SIMD_NEON)
+    return &halfToFloatsNeon;
+#endif
+    return &halfToFloatsScalar;
+}
+
+// Scales, saturates (NaN maps to the minimum) and rounds to nearest-even
+template <typename T>
+T toFixedPoint(float value, float scale) noexcept {
+    constexpr auto Minimum = static_cast<float>(std::numeric_limits<T>::min());
+    constexpr auto Maximum = std::is_same_v<T, int16_t> ? 32767.0f : 2147483520.0f;
+
+    float scaled = value * scale;
+    scaled       = scaled > Minimum ? scaled : Minimum;
+    scaled       = scaled < Maximum ? scaled : Maximum;
+    return static_cast<T>(std::nearbyint(scaled));
+}
+
+template <typename T>
+void floatsToFixed(const float* values, uint8_t* out, size_t count, float scale) noexcept {
+    size_t i = 0;
+#if defined(BSTREAM_SIMD_SSE2)
+    __m128 factor  = _mm_set1_ps(scale);
+    __m128 minimum = _mm_set1_ps(static_cast<float>(std::numeric_limits<T>::min()));
+    __m128 maximum = _mm_set1_ps(std::is_same_v<T, int16_t> ? 32767.0f : 2147483520.0f);
+    for (; i + 8 <= count; i += 8) {
+        __m128  low    = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(values + i), factor), minimum), maximum);
+        __m128  high   = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(values + i + 4), factor), minimum), maximum);
+        __m128i first  = _mm_cvtps_epi32(low);
+        __m128i second = _mm_cvtps_epi32(high);
+        if constexpr (std::is_same_v<T, int16_t>) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2), _mm_packs_epi32(first, second));
+        } else {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4), first);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4 + 16), second);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        T fixed = toFixedPoint<T>(values[i], scale);
+        std::memcpy(out + i * sizeof(T), &fixed, sizeof(T));
+    }
+}
+
+template <typename T>
+void fixedToFloats(const uint8_t* data, float* values, size_t count, float inverseScale) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        T fixed;
+        std::memcpy(&fixed, data + i * sizeof(T), sizeof(T));
+        values[i] = static_cast<float>(fixed) * inverseScale;
+    }
+}
+
+template <typename T>
+bool appendFixed(detail::ByteSink out, std::span<const float> values, uint8_t fractionalBits, bool bigEndian) {
+    if (fractionalBits >= sizeof(T) * 8) { return false; }
+    float   scale = std::ldexp(1.0f, fractionalBits);
+    uint8_t fixed[ChunkSize * sizeof(T)];
+    out.reserve(values.size() * sizeof(T));
+    for (size_t offset = 0; offset < values.size(); offset += ChunkSize) {
+        size_t count = std::min(ChunkSize, values.size() - offset);
+        floatsToFixed<T>(values.data() + offset, fixed, count, scale);
+        if (bigEndian) { detail::swapEndianArray(fixed, count, sizeof(T)); }
+        out.append(fixed, count * sizeof(T));
+    }
+    return true;
+}
+
+template <typename T>
+bool decodeFixed(
+    std::string_view unread,
+    size_t&          consumed,
+    std::span<float> values,
+    uint8_t          fractionalBits,
+    bool             bigEndian
+) {
+    size_t length = values.size() * sizeof(T);
+    if (fractionalBits >= sizeof(T) * 8 || length > unread.size()) { return false; }
+
+    auto  data         = reinterpret_cast<const uint8_t*>(unread.data());
+    float inverseScale = std::ldexp(1.0f, -fractionalBits);
+    if (bigEndian) {
+        std::vector<uint8_t> swapped(data, data + length);
+        detail::swapEndianArray(swapped.data(), values.size(), sizeof(T));
+        fixedToFloats<T>(swapped.data(), values.data(), values.size(), inverseScale);
+    } else {
+        fixedToFloats<T>(data, values.data(), values.size(), inverseScale);
+    }
+    consumed = length;
+    return true;
+}
+
+} // namespace
+
+namespace detail {
+
+void appendNormalizedFloats(ByteSink out, std::span<const float> values, bool bigEndian) {
+    uint8_t bytes[ChunkSize * MaxVarInt64Length];
+    for (size_t offset = 0; offset < values.size(); offset += ChunkSize) {
+        size_t count  = std::min(ChunkSize, values.size() - offset);
+        size_t length = 0;
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t encoded = zigzagEncode(static_cast<int64_t>(values[offset + i] * 2147483647.0f));
+            if (bigEndian) { encoded = swapEndian(encoded); }
+            length += encodeVarInt(encoded, bytes + length);
+        }
+        out.append(bytes, length);
+    }
+}
+
+void appendHalfFloats(ByteSink out, std::span<const float> values, bool bigEndian) {
+    static const ToHalfKernel kernel = selectToHalfKernel();
+
+    uint8_t halves[ChunkSize * sizeof(uint16_t)];
+    out.reserve(values.size() * sizeof(uint16_t));
+    for (size_t offset = 0; offset < values.size(); offset += ChunkSize) {
+        size_t count = std::min(ChunkSize, values.size() - offset);
+        kernel(values.data() + offset, halves, count);
+        if (bigEndian) { swapEndianArray(halves, count, sizeof(uint16_t)); }
+        out.append(halves, count * sizeof(uint16_t));
+    }
+}
+
+size_t measureNormalizedFloats(std::span<const float> values, bool bigEndian) noexcept {
+    size_t size = 0;
+    for (float value : values) {
+        uint64_t encoded = zigzagEncode(static_cast<int64_t>(value * 2147483647.0f));
+        if (bigEndian) { encoded = swapEndian(encoded); }
+        size += varIntLength(encoded);
+    }
+    return size;
+}
+
+bool appendFixed16Floats(ByteSink out, std::span<const float> values, uint8_t fractionalBits, bool bigEndian) {
+    return appendFixed<int16_t>(out, values, fractionalBits, bigEndian);
+}
+
+bool appendFixed32Floats(ByteSink out, std::span<const float> values, uint8_t fractionalBits, bool bigEndian) {
+    return appendFixed<int32_t>(out, values, fractionalBits, bigEndian);
+}
+
+} // namespace detail
+
+void BinaryStream::writeNormalizedFloats(std::span<const float> values) {
+    detail::appendNormalizedFloats(detail::ByteSink(mBuffer), values, mBigEndian);
+    mBufferView = mBuffer;
+}
+
+void BinaryStream::writeHalfFloats(std::span<const float> values) {
+    detail::appendHalfFloats(detail::ByteSink(mBuffer), values, mBigEndian);
+    mBufferView = mBuffer;
+}
+
+bool BinaryStream::writeFixed16Floats(std::span<const float> values, uint8_t fractionalBits) {
+    bool written = detail::appendFixed16Floats(detail::ByteSink(mBuffer), values, fractionalBits, mBigEndian);
+    mBufferView  = mBuffer;
+    return written;
+}
+
+bool BinaryStream::writeFixed32Floats(std::span<const float> values, uint8_t fractionalBits) {
+    bool written = detail::appendFixed32Floats(detail::ByteSink(mBuffer), values, fractionalBits, mBigEndian);
+    mBufferView  = mBuffer;
+    return written;
+}
+
+namespace detail {
+
+bool decodeNormalizedFloats(std::string_view unread, size_t& consumed, std::span<float> values, bool bigEndian) {
+    auto begin  = reinterpret_cast<const uint8_t*>(unread.data());
+    auto end    = begin + unread.size();
+    auto cursor = begin;
+    for (auto& value : values) {
+        uint64_t encoded;
+        if (!decodeVarInt(cursor, end, encoded)) { return false; }
+        if (bigEndian) { encoded = swapEndian(encoded); }
+        value = static_cast<float>(zigzagDecode(encoded)) / 2147483647.0f;
+    }
+    consumed = static_cast<size_t>(cursor - begin);
+    return true;
+}
+
+bool decodeHalfFloats(std::string_view unread, size_t& consumed, std::span<float> values, bool bigEndian) {
+    static const FromHalfKernel kernel = selectFromHalfKernel();
+
+    size_t length = values.size() * sizeof(uint16_t);
+    if (length > unread.size()) { return false; }
+
+    auto data = reinterpret_cast<const uint8_t*>(unread.data());
+    if (bigEndian) {
+        std::vector<uint8_t> swapped(data, data + length);
+        swapEndianArray(swapped.data(), values.size(), sizeof(uint16_t));
+        kernel(swapped.data(), values.data(), values.size());
+    } else {
+        kernel(data, values.data(), values.size());
+    }
+    consumed = length;
+    return true;
+}
+
+bool decodeFixed16Floats(
+    std::string_view unread,
+    size_t&          consumed,
+    std::span<float> values,
+    uint8_t          fractionalBits,
+    bool             bigEndian
+) {
+    return decodeFixed<int16_t>(unread, consumed, values, fractionalBits, bigEndian);
+}
+
+bool decodeFixed32Floats(
+    std::string_view unread,
+    size_t&          consumed,
+    std::span<float> values,
+    uint8_t          fractionalBits,
+    bool             bigEndian
+) {
+    return decodeFixed<int32_t>(unread, consumed, values, fractionalBits, bigEndian);
+}
+
+} // namespace detail
+
+bool ReadOnlyBinaryStream::getNormalizedFloats(std::span<float> values) {
+    return decodeUnread([&](std::string_view unread, size_t& consumed) {
+        return detail::decodeNormalizedFloats(unread, consumed, values, mBigEndian);
+    });
+}
+
+bool ReadOnlyBinaryStream::getHalfFloats(std::span<float> values) {
+    return decodeUnread([&](std::string_view unread, size_t& consumed) {
+        return detail::decodeHalfFloats(unread, consumed, values, mBigEndian);
+    });
+}
+
+bool ReadOnlyBinaryStream::getFixed16Floats(std::span<float> values, uint8_t fractionalBits) {
+    return decodeUnread([&](std::string_view unread, size_t& consumed) {
+        return detail::decodeFixed16Floats(unread, consumed, values, fractionalBits, mBigEndian);
+    });
+}
+
+bool ReadOnlyBinaryStream::getFixed32Floats(std::span<float> values, uint8_t fractionalBits) {
+    return decodeUnread([&](std::string_view unread, size_t& consumed) {
+        return detail::decodeFixed32Floats(unread, consumed, values, fractionalBits, mBigEndian);
+    });
+}
+
+} // namespace bstream
@@ -6,6 +6,10 @@
 // SPDX-License-Identifier: MPL-2.0
 
 #include "binarystream/ReadOnlyBinaryStream.hpp"
+#include "binarystream/PackedBitArray.hpp"
+#include "binarystream/detail/VarInt.hpp"
+#include "detail/BitPacking.hpp"
+#include <cstring>
 #include <span>
 
 namespace bstream {
@@ -13,6 +17,7 @@ namespace bstream {
 ReadOnlyBinaryStream::ReadOnlyBinaryStream(std::string_view buffer, bool copyBuffer, bool bigEndian)
 : mReadPointer(0),
   mHasOverflowed(false),
+  mValidateUtf8(false),
   mBigEndian(bigEndian) {
     if (copyBuffer) {
         mOwnedBuffer = buffer;
@@ -31,6 +36,41 @@ ReadOnlyBinaryStream::ReadOnlyBinaryStream(const char* data, size_t size, bool c
 ReadOnlyBinaryStream::ReadOnlyBinaryStream(const uint8_t* data, size_t size, bool copyBuffer, bool bigEndian)
 : ReadOnlyBinaryStream(reinterpret_cast<const char*>(data), size, copyBuffer, bigEndian) {}
 
+ReadOnlyBinaryStream::ReadOnlyBinaryStream(SharedBuffer buffer, bool bigEndian)
+: mSharedBuffer(std::move(buffer)),
+  mReadPointer(0),
+  mHasOverflowed(false),
+  mValidateUtf8(false),
+  mBigEndian(bigEndian) {
+    mBufferView = mSharedBuffer.view();
+}
+
+ReadOnlyBinaryStream::ReadOnlyBinaryStream(ReadOnlyBinaryStream const& other)
+: mOwnedBuffer(other.mOwnedBuffer),
+  mSharedBuffer(other.mSharedBuffer),
+  mBufferView(other.mBufferView),
+  mReadPointer(other.mReadPointer),
+  mHasOverflowed(other.mHasOverflowed),
+  mValidateUtf8(other.mValidateUtf8),
+  mBigEndian(other.mBigEndian) {
+    if (other.ownsBuffer()) { mBufferView = mOwnedBuffer; }
+}
+
+ReadOnlyBinaryStream::ReadOnlyBinaryStream(ReadOnlyBinaryStream&& other) noexcept
+: mReadPointer(other.mReadPointer),
+  mHasOverflowed(other.mHasOverflowed),
+  mValidateUtf8(other.mValidateUtf8),
+  mBigEndian(other.mBigEndian) {
+    bool owned    = other.ownsBuffer();
+    mOwnedBuffer  = std::move(other.mOwnedBuffer);
+    mSharedBuffer = std::move(other.mSharedBuffer);
+    mBufferView   = owned ? std::string_view(mOwnedBuffer) : other.mBufferView;
+
+    other.mOwnedBuffer.clear();
+    other.mBufferView  = std::string_view();
+    other.mReadPointer = 0;
+}
+
 template <typename T>
 bool ReadOnlyBinaryStream::read(T* target, bool bigEndian) noexcept {
     if (mHasOverflowed) { return false; }
@@ -41,12 +81,57 @@ bool ReadOnlyBinaryStream::read(T* target, bool bigEndian) noexcept {
         return false;
     }
 
-    std::copy_n(mBufferView.begin() + mReadPointer, sizeof(T), reinterpret_cast<char*>(target));
+    *target      = detail::loadFixed<T>(mBufferView.data() + mReadPointer, bigEndian);
     mReadPointer = newReadPointer;
-    if (bigEndian) { *target = detail::swapEndian(*target); }
     return true;
 }
 
+template <typename T>
+T ReadOnlyBinaryStream::readVarInt() noexcept {
+    auto unread = unreadView();
+    auto begin  = reinterpret_cast<const uint8_t*>(unread.data());
+    auto cursor = begin;
+    T    value  = 0;
+    bool valid  = detail::decodeVarInt(cursor, begin + unread.size(), value);
+
+    mReadPointer += static_cast<size_t>(cursor - begin);
+    if (!valid) {
+        mHasOverflowed = true;
+        return value;
+    }
+    return mBigEndian ? detail::swapEndian(value) : value;
+}
+
+bool ReadOnlyBinaryStream::checkUtf8(std::string_view text) noexcept {
+    if (!mValidateUtf8 || detail::isValidUtf8(text)) { return true; }
+    mHasOverflowed = true;
+    return false;
+}
+
+bool ReadOnlyBinaryStream::ownsBuffer() const noexcept {
+    return !mOwnedBuffer.empty() && mBufferView.data() == mOwnedBuffer.data();
+}
+
+// Validates the bytes in place so an invalid string is never copied out
+void ReadOnlyBinaryStream::readString(std::string& outString, size_t length) {
+    if (mReadPointer + length > mBufferView.size()) {
+        mHasOverflowed = true;
+        outString.clear();
+        return;
+    }
+    auto text     = mBufferView.substr(mReadPointer, length);
+    mReadPointer += length;
+    if (checkUtf8(text)) {
+        outString.assign(text);
+    } else {
+        outString.clear();
+    }
+}
+
+std::string_view ReadOnlyBinaryStream::unreadView() const noexcept {
+    return mReadPointer < mBufferView.size() ? mBufferView.substr(mReadPointer) : std::string_view();
+}
+
 size_t ReadOnlyBinaryStream::getPosition() const noexcept { return mReadPointer; }
 
 void ReadOnlyBinaryStream::setPosition(size_t value) noexcept { mReadPointer = value; }
@@ -71,6 +156,10 @@ bool ReadOnlyBinaryStream::operator==(ReadOnlyBinaryStream const& other) const n
     return mBufferView == other.mBufferView;
 }
 
+void ReadOnlyBinaryStream::setUtf8Validation(bool enabled) noexcept { mValidateUtf8 = enabled; }
+
+bool ReadOnlyBinaryStream::isUtf8ValidationEnabled() const noexcept { return mValidateUtf8; }
+
 bool ReadOnlyBinaryStream::getBytes(void* target, size_t num) noexcept {
     if (mHasOverflowed) { return false; }
     if (num == 0) { return true; }
@@ -146,67 +235,13 @@ int16_t ReadOnlyBinaryStream::getSignedShort() noexcept {
     return value;
 }
 
-uint32_t ReadOnlyBinaryStream::getUnsignedVarInt() noexcept {
-    uint32_t value = 0;
-    unsigned shift = 0;
-    uint8_t  byte;
-
-    do {
-        if (shift >= 35) {
-            mHasOverflowed = true;
-            return value;
-        }
+uint32_t ReadOnlyBinaryStream::getUnsignedVarInt() noexcept { return readVarInt<uint32_t>(); }
 
-        if (mReadPointer >= mBufferView.size()) {
-            mHasOverflowed = true;
-            return value;
-        }
+uint64_t ReadOnlyBinaryStream::getUnsignedVarInt64() noexcept { return readVarInt<uint64_t>(); }
 
-        byte   = static_cast<uint8_t>(mBufferView[mReadPointer++]);
-        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
-        shift += 7;
+int32_t ReadOnlyBinaryStream::getVarInt() noexcept { return detail::zigzagDecode(getUnsignedVarInt()); }
 
-    } while (byte & 0x80);
-
-    if (mBigEndian) { value = detail::swapEndian(value); }
-    return value;
-}
-
-uint64_t ReadOnlyBinaryStream::getUnsignedVarInt64() noexcept {
-    uint64_t value = 0;
-    unsigned shift = 0;
-    uint8_t  byte;
-
-    do {
-        if (shift >= 70) {
-            mHasOverflowed = true;
-            return value;
-        }
-
-        if (mReadPointer >= mBufferView.size()) {
-            mHasOverflowed = true;
-            return value;
-        }
-
-        byte   = static_cast<uint8_t>(mBufferView[mReadPointer++]);
-        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
-        shift += 7;
-
-    } while (byte & 0x80);
-
-    if (mBigEndian) { value = detail::swapEndian(value); }
-    return value;
-}
-
-int32_t ReadOnlyBinaryStream::getVarInt() noexcept {
-    uint32_t value = getUnsignedVarInt();
-    return (value & 1) ? ~(value >> 1) : (value >> 1);
-}
-
-int64_t ReadOnlyBinaryStream::getVarInt64() noexcept {
-    uint64_t value = getUnsignedVarInt64();
-    return (value & 1) ? ~(value >> 1) : (value >> 1);
-}
+int64_t ReadOnlyBinaryStream::getVarInt64() noexcept { return detail::zigzagDecode(getUnsignedVarInt64()); }
 
 float ReadOnlyBinaryStream::getNormalizedFloat() noexcept { return static_cast<float>(getVarInt64()) / 2147483647.0f; }
 
@@ -218,17 +253,17 @@ int32_t ReadOnlyBinaryStream::getSignedBigEndianInt() noexcept {
 
 void ReadOnlyBinaryStream::getString(std::string& outString) {
     uint32_t length = getUnsignedVarInt();
-    getRawBytes(outString, static_cast<size_t>(length));
+    readString(outString, static_cast<size_t>(length));
 }
 
 void ReadOnlyBinaryStream::getShortString(std::string& outString) {
     short length = getSignedShort();
-    getRawBytes(outString, static_cast<size_t>(length));
+    readString(outString, static_cast<size_t>(length));
 }
 
 void ReadOnlyBinaryStream::getLongString(std::string& outString) {
     int length = getSignedInt();
-    getRawBytes(outString, static_cast<size_t>(length));
+    readString(outString, static_cast<size_t>(length));
 }
 
 std::string ReadOnlyBinaryStream::getString() {
@@ -253,6 +288,7 @@ std::string_view ReadOnlyBinaryStream::getStringView() {
     auto length   = static_cast<size_t>(getUnsignedVarInt());
     auto result   = mBufferView.substr(mReadPointer, length);
     mReadPointer += length;
+    if (!checkUtf8(result)) { return {}; }
     return result;
 }
 
@@ -260,6 +296,7 @@ std::string_view ReadOnlyBinaryStream::getShortStringView() {
     auto length   = static_cast<size_t>(getSignedShort());
     auto result   = mBufferView.substr(mReadPointer, length);
     mReadPointer += length;
+    if (!checkUtf8(result)) { return {}; }
     return result;
 }
 
@@ -267,6 +304,7 @@ std::string_view ReadOnlyBinaryStream::getLongStringView() {
     auto length   = static_cast<size_t>(getSignedInt());
     auto result   = mBufferView.substr(mReadPointer, length);
     mReadPointer += length;
+    if (!checkUtf8(result)) { return {}; }
     return result;
 }
 
@@ -310,4 +348,76 @@ std::string ReadOnlyBinaryStream::getRawBytes(size_t length) {
     return result;
 }
 
+ReadOnlyBinaryStream ReadOnlyBinaryStream::overflowedSlice() const {
+    ReadOnlyBinaryStream result(std::string_view(), false, mBigEndian);
+    result.mHasOverflowed = true;
+    return result;
+}
+
+ReadOnlyBinaryStream ReadOnlyBinaryStream::slice(size_t offset, size_t length) const {
+    if (offset > mBufferView.size() || length > mBufferView.size() - offset) { return overflowedSlice(); }
+
+    auto range = mBufferView.substr(offset, length);
+    if (mSharedBuffer) {
+        ReadOnlyBinaryStream result(mSharedBuffer, mBigEndian);
+        result.mBufferView   = range;
+        result.mValidateUtf8 = mValidateUtf8;
+        return result;
+    }
+    ReadOnlyBinaryStream result = ownsBuffer() ? ReadOnlyBinaryStream(SharedBuffer(range), mBigEndian)
+                                               : ReadOnlyBinaryStream(range, false, mBigEndian);
+    result.mValidateUtf8 = mValidateUtf8;
+    return result;
+}
+
+ReadOnlyBinaryStream ReadOnlyBinaryStream::readSlice(size_t length) {
+    if (mHasOverflowed || mReadPointer > mBufferView.size() || length > mBufferView.size() - mReadPointer) {
+        mHasOverflowed = true;
+        return overflowedSlice();
+    }
+    ReadOnlyBinaryStream result = slice(mReadPointer, length);
+    mReadPointer += length;
+    return result;
+}
+
+SharedBuffer const& ReadOnlyBinaryStream::sharedBuffer() const noexcept { return mSharedBuffer; }
+
+bool ReadOnlyBinaryStream::getPackedBitArray(std::span<uint16_t> entries, uint8_t bitsPerEntry) {
+    return decodeUnread([&](std::string_view unread, size_t& consumed) {
+        return detail::decodePackedBitArray(unread, consumed, entries, bitsPerEntry, mBigEndian);
+    });
+}
+
+namespace detail {
+
+bool decodePackedBitArray(
+    std::string_view    unread,
+    size_t&             consumed,
+    std::span<uint16_t> entries,
+    uint8_t             bitsPerEntry,
+    bool                bigEndian
+) {
+    if (!PackedBitArray::isValidBitsPerEntry(bitsPerEntry)) { return false; }
+
+    size_t wordCount = PackedBitArray::wordCount(entries.size(), bitsPerEntry);
+    size_t length    = wordCount * sizeof(uint32_t);
+    if (length > unread.size()) { return false; }
+
+    consumed = length;
+    if (wordCount == 0) { return true; }
+
+    auto words = reinterpret_cast<const uint8_t*>(unread.data());
+    if (bigEndian) {
+        std::vector<uint32_t> swapped(wordCount);
+        std::memcpy(swapped.data(), words, length);
+        swapEndianArray(swapped.data(), wordCount, sizeof(uint32_t));
+        unpackBitArray(reinterpret_cast<const uint8_t*>(swapped.data()), bitsPerEntry, entries.data(), entries.size());
+    } else {
+        unpackBitArray(words, bitsPerEntry, entries.data(), entries.size());
+    }
+    return true;
+}
+
+} // namespace detail
+
 } // namespace bstream
\ No newline at end of file
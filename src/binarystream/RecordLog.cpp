@@ -0,0 +1,188 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "binarystream/BinaryReader.hpp"
+#include "binarystream/RecordLog.hpp"
+#include "binarystream/detail/VarInt.hpp"
+
+namespace bstream {
+
+namespace {
+
+constexpr std::string_view LogMagic    = "BSRL";
+constexpr std::string_view IndexMagic  = "BSRI";
+constexpr uint8_t          LogVersion  = 1;
+constexpr size_t           HeaderSize  = 5;
+constexpr size_t           EntrySize   = sizeof(uint64_t) + sizeof(int64_t);
+constexpr size_t           TrailerSize = sizeof(uint64_t) * 2 + 4;
+
+// Decodes the record header at offset; payloadOffset and length describe the payload on success
+bool decodeRecord(
+    std::string_view data,
+    size_t           offset,
+    int64_t&         timestamp,
+    size_t&          payloadOffset,
+    size_t&          length
+) noexcept {
+    auto     begin  = reinterpret_cast<const uint8_t*>(data.data());
+    auto     cursor = begin + offset;
+    auto     end    = begin + data.size();
+    uint64_t encodedTimestamp;
+    uint64_t encodedLength;
+    if (!detail::decodeVarInt(cursor, end, encodedTimestamp) || !detail::decodeVarInt(cursor, end, encodedLength)) {
+        return false;
+    }
+    auto remaining = static_cast<size_t>(end - cursor);
+    if (encodedLength > remaining) { return false; }
+    timestamp     = detail::zigzagDecode(encodedTimestamp);
+    payloadOffset = static_cast<size_t>(cursor - begin);
+    length        = static_cast<size_t>(encodedLength);
+    return true;
+}
+
+static_assert(std::is_nothrow_move_constructible_v<RecordLogWriter>);
+
+} // namespace
+
+RecordLogWriter::RecordLogWriter() : mDrainedBytes(0), mFinished(false) {
+    mStream.writeRawBytes(LogMagic);
+    mStream.writeUnsignedChar(LogVersion);
+}
+
+bool RecordLogWriter::append(int64_t timestamp, std::string_view payload) {
+    if (mFinished || (!mIndex.empty() && timestamp < mIndex.back().mTimestamp)) { return false; }
+    mIndex.push_back({mDrainedBytes + mStream.data().size(), timestamp});
+    mStream.writeVarInt64(timestamp);
+    mStream.writeUnsignedVarInt64(payload.size());
+    mStream.writeRawBytes(payload);
+    return true;
+}
+
+size_t RecordLogWriter::recordCount() const noexcept { return mIndex.size(); }
+
+std::string RecordLogWriter::drain() {
+    mDrainedBytes += mStream.data().size();
+    return mStream.getAndReleaseData();
+}
+
+std::string RecordLogWriter::finish() {
+    if (mFinished) { return {}; }
+    mFinished          = true;
+    uint64_t indexSite = mDrainedBytes + mStream.data().size();
+    mStream.reserve(mStream.data().size() + mIndex.size() * EntrySize + TrailerSize);
+    for (auto const& entry : mIndex) {
+        mStream.writeUnsignedInt64(entry.mOffset);
+        mStream.writeSignedInt64(entry.mTimestamp);
+    }
+    mStream.writeUnsignedInt64(indexSite);
+    mStream.writeUnsignedInt64(mIndex.size());
+    mStream.writeRawBytes(IndexMagic);
+    return drain();
+}
+
+RecordLogReader::RecordLogReader(std::string_view data)
+: mStream(data, false, false),
+  mRecordCount(0),
+  mIsValid(false),
+  mIsIndexRebuilt(false) {
+    load();
+}
+
+RecordLogReader::RecordLogReader(SharedBuffer data)
+: mStream(std::move(data)),
+  mRecordCount(0),
+  mIsValid(false),
+  mIsIndexRebuilt(false) {
+    load();
+}
+
+void RecordLogReader::load() {
+    std::string_view data = mStream.view();
+    if (data.size() < HeaderSize || !data.starts_with(LogMagic) || static_cast<uint8_t>(data[4]) != LogVersion) {
+        return;
+    }
+    mIsValid = true;
+    if (!loadFooter()) { rebuildIndex(); }
+}
+
+bool RecordLogReader::loadFooter() {
+    std::string_view data = mStream.view();
+    if (data.size() < HeaderSize + TrailerSize || !data.ends_with(IndexMagic)) { return false; }
+
+    size_t       trailer = data.size() - TrailerSize;
+    BinaryReader reader(data.substr(trailer));
+    uint64_t     indexOffset = reader.getUnsignedInt64();
+    uint64_t     count       = reader.getUnsignedInt64();
+    uint64_t     available   = trailer - HeaderSize;
+    if (count > available / EntrySize || indexOffset != trailer - count * EntrySize) { return false; }
+
+    mIndex       = data.substr(static_cast<size_t>(indexOffset), static_cast<size_t>(count) * EntrySize);
+    mRecordCount = static_cast<size_t>(count);
+    return true;
+}
+
+// Walks the length prefixes from the header and stops at the first incomplete record, or at a timestamp the writer
+// would have rejected, which usually marks the start of a partially written index
+void RecordLogReader::rebuildIndex() {
+    std::string_view data   = mStream.view();
+    size_t           offset = HeaderSize;
+    while (offset < data.size()) {
+        int64_t timestamp;
+        size_t  payloadOffset;
+        size_t  length;
+        if (!decodeRecord(data, offset, timestamp, payloadOffset, length)) { break; }
+        if (!mRebuiltIndex.empty() && timestamp < mRebuiltIndex.back().mTimestamp) { break; }
+        mRebuiltIndex.push_back({offset, timestamp});
+        offset = payloadOffset + length;
+    }
+    mRecordCount    = mRebuiltIndex.size();
+    mIsIndexRebuilt = true;
+}
+
+bool RecordLogReader::isValid() const noexcept { return mIsValid; }
+
+bool RecordLogReader::isIndexRebuilt() const noexcept { return mIsIndexRebuilt; }
+
+size_t RecordLogReader::recordCount() const noexcept { return mRecordCount; }
+
+RecordLogEntry RecordLogReader::entry(size_t index) const noexcept {
+    if (index >= mRecordCount) { return {0, 0}; }
+    if (mIsIndexRebuilt) { return mRebuiltIndex[index]; }
+    BinaryReader reader(mIndex.substr(index * EntrySize, EntrySize));
+    uint64_t     offset = reader.getUnsignedInt64();
+    return {offset, reader.getSignedInt64()};
+}
+
+std::optional<ReadOnlyBinaryStream> RecordLogReader::record(size_t index) const {
+    if (index >= mRecordCount) { return std::nullopt; }
+    RecordLogEntry   location = entry(index);
+    std::string_view data     = mStream.view();
+    int64_t          timestamp;
+    size_t           payloadOffset;
+    size_t           length;
+    if (location.mOffset >= data.size()
+        || !decodeRecord(data, static_cast<size_t>(location.mOffset), timestamp, payloadOffset, length)) {
+        return std::nullopt;
+    }
+    return mStream.slice(payloadOffset, length);
+}
+
+size_t RecordLogReader::lowerBound(int64_t timestamp) const noexcept {
+    size_t low  = 0;
+    size_t high = mRecordCount;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (entry(middle).mTimestamp < timestamp) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+} // namespace bstream
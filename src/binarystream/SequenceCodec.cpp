@@ -0,0 +1,577 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "binarystream/BasicBinaryWriter.hpp"
+#include "binarystream/BinaryStream.hpp"
+#include "binarystream/SizeMeasuringStream.hpp"
+#include "binarystream/detail/VarInt.hpp"
+#include "detail/Simd.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace bstream {
+
+namespace {
+
+constexpr size_t ChunkSize = 64;
+
+// Maps each value against its predecessor (the first against T{}) and appends the results as varints. The mapping runs
+// over a whole chunk first so it can be vectorized, then the chunk is encoded into a stack buffer and appended at once.
+template <typename U, typename T, typename Transform>
+void appendDerivedVarInts(detail::ByteSink out, std::span<const T> values, Transform transform) {
+    U       derived[ChunkSize];
+    uint8_t bytes[ChunkSize * detail::MaxVarInt64Length];
+    T       previous{};
+    for (size_t offset = 0; offset < values.size(); offset += ChunkSize) {
+        size_t   count = std::min(ChunkSize, values.size() - offset);
+        const T* chunk = values.data() + offset;
+
+        derived[0] = transform(chunk[0], previous);
+        for (size_t i = 1; i < count; ++i) { derived[i] = transform(chunk[i], chunk[i - 1]); }
+        previous = chunk[count - 1];
+
+        size_t length = 0;
+        for (size_t i = 0; i < count; ++i) { length += detail::encodeVarInt(derived[i], bytes + length); }
+        out.append(bytes, length);
+    }
+}
+
+template <typename T, typename Transform>
+size_t measureDerivedVarInts(std::span<const T> values, Transform transform) noexcept {
+    size_t size = 0;
+    T      previous{};
+    for (T value : values) {
+        size     += detail::varIntLength(transform(value, previous));
+        previous  = value;
+    }
+    return size;
+}
+
+template <typename U, typename T, typename Restore>
+bool readDerivedVarInts(std::string_view unread, size_t& consumed, std::span<T> values, Restore restore) noexcept {
+    auto begin  = reinterpret_cast<const uint8_t*>(unread.data());
+    auto end    = begin + unread.size();
+    auto cursor = begin;
+    T    previous{};
+    for (auto& value : values) {
+        U encoded;
+        if (!detail::decodeVarInt(cursor, end, encoded)) { return false; }
+        value    = restore(encoded, previous);
+        previous = value;
+    }
+    consumed = static_cast<size_t>(cursor - begin);
+    return true;
+}
+
+template <typename T>
+auto deltaTransform(T current, T previous) noexcept {
+    using U = std::make_unsigned_t<T>;
+    return detail::zigzagEncode(static_cast<T>(static_cast<U>(current) - static_cast<U>(previous)));
+}
+
+template <typename T>
+T deltaRestore(std::make_unsigned_t<T> encoded, T previous) noexcept {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<T>(static_cast<U>(previous) + static_cast<U>(detail::zigzagDecode(encoded)));
+}
+
+// Fields of up to 32 bits, lowest bits first, into a buffer with room for them
+class BitWriter {
+    uint8_t* mBegin;
+    uint8_t* mOut;
+    uint64_t mBits;
+    unsigned mUsed;
+
+public:
+    explicit BitWriter(uint8_t* out) noexcept : mBegin(out), mOut(out), mBits(0), mUsed(0) {}
+
+    void put(uint64_t value, unsigned count) noexcept {
+        mBits |= value << mUsed;
+        mUsed += count;
+        while (mUsed >= 8) {
+            *mOut++   = static_cast<uint8_t>(mBits);
+            mBits   >>= 8;
+            mUsed    -= 8;
+        }
+    }
+
+    void putWide(uint64_t value, unsigned count) noexcept {
+        if (count > 32) {
+            put(value & 0xFFFFFFFF, 32);
+            put(value >> 32, count - 32);
+        } else {
+            put(value, count);
+        }
+    }
+
+    // Pads the last byte with zero bits and returns the end of the output
+    uint8_t* finish() noexcept {
+        if (mUsed > 0) { *mOut++ = static_cast<uint8_t>(mBits); }
+        mBits = 0;
+        mUsed = 0;
+        return mOut;
+    }
+
+    // Returns the number of whole bytes in the buffer and starts refilling it from the beginning; the bits of a
+    // partial byte carry over
+    size_t drain() noexcept {
+        auto size = static_cast<size_t>(mOut - mBegin);
+        mOut      = mBegin;
+        return size;
+    }
+};
+
+// Stands in for BitWriter when only the encoded length is needed
+class BitCounter {
+    size_t mBits;
+
+public:
+    BitCounter() noexcept : mBits(0) {}
+
+    void put(uint64_t, unsigned count) noexcept { mBits += count; }
+    void putWide(uint64_t, unsigned count) noexcept { mBits += count; }
+
+    [[nodiscard]] size_t bytes() const noexcept { return (mBits + 7) / 8; }
+};
+
+class BitReader {
+    const uint8_t* mCursor;
+    const uint8_t* mEnd;
+    uint64_t       mBits;
+    unsigned       mUsed;
+
+public:
+    BitReader(const uint8_t* begin, const uint8_t* end) noexcept : mCursor(begin), mEnd(end), mBits(0), mUsed(0) {}
+
+    bool get(unsigned count, uint64_t& value) noexcept {
+        while (mUsed < count) {
+            if (mCursor == mEnd) { return false; }
+            mBits |= static_cast<uint64_t>(*mCursor++) << mUsed;
+            mUsed += 8;
+        }
+        value   = mBits & ((uint64_t(1) << count) - 1);
+        mBits >>= count;
+        mUsed  -= count;
+        return true;
+    }
+
+    bool getWide(unsigned count, uint64_t& value) noexcept {
+        if (count <= 32) { return get(count, value); }
+        uint64_t high;
+        if (!get(32, value) || !get(count - 32, high)) { return false; }
+        value |= high << 32;
+        return true;
+    }
+
+    // The first byte after the field last read; the rest of a partially read byte is padding
+    [[nodiscard]] const uint8_t* position() const noexcept { return mCursor; }
+};
+
+// Gorilla-style XOR coding, with the leading-zero classes and trailing-zero threshold of Chimp (Liakos et al., 2022).
+// Each bit pattern is XORed with the previous one (the first with zero) and written under a 2-bit code:
+//   0: the XOR is zero
+//   1: more than 6 trailing zeros; 3-bit leading-zero class, meaningful length (5 bits for floats, 6 for doubles),
+//      then the bits between the leading and trailing zeros
+//   2: same leading-zero class as the previous value; every bit after the leading zeros
+//   3: new leading-zero class as 3 bits; every bit after the leading zeros
+// Leading-zero counts are rounded down to one of eight classes. The stream is padded to a whole byte.
+template <typename U>
+struct XorLayout {
+    static constexpr unsigned Bits        = sizeof(U) * 8;
+    static constexpr unsigned LengthBits  = Bits == 32 ? 5 : 6;
+    static constexpr unsigned MaxTrailing = 6;
+    static constexpr unsigned NoClass     = 8;
+    static constexpr size_t   MaxBits     = 2 + 3 + Bits;
+
+    static constexpr std::array<unsigned, 8> Classes =
+        Bits == 32 ? std::array<unsigned, 8>{0, 4, 6, 8, 10, 12, 14, 16}
+                   : std::array<unsigned, 8>{0, 8, 12, 16, 18, 20, 22, 24};
+
+    static constexpr unsigned classOf(unsigned leading) noexcept {
+        unsigned index = 7;
+        while (Classes[index] > leading) { --index; }
+        return index;
+    }
+};
+
+// Carries the previous value and leading-zero class from one run of values to the next
+template <typename U>
+class XorEncoder {
+    using Layout = XorLayout<U>;
+
+    U        mPrevious;
+    unsigned mStoredClass;
+
+public:
+    XorEncoder() noexcept : mPrevious(0), mStoredClass(Layout::NoClass) {}
+
+    template <typename T, typename Writer>
+    void encode(std::span<const T> values, Writer& writer) noexcept {
+        for (T value : values) {
+            U bits    = std::bit_cast<U>(value);
+            U xored   = bits ^ mPrevious;
+            mPrevious = bits;
+            if (xored == 0) {
+                writer.put(0, 2);
+                mStoredClass = Layout::NoClass;
+                continue;
+            }
+            unsigned index    = Layout::classOf(static_cast<unsigned>(std::countl_zero(xored)));
+            unsigned leading  = Layout::Classes[index];
+            auto     trailing = static_cast<unsigned>(std::countr_zero(xored));
+            if (trailing > Layout::MaxTrailing) {
+                unsigned length = Layout::Bits - leading - trailing;
+                writer.put(1 | (index << 2) | (length << 5), 5 + Layout::LengthBits);
+                writer.putWide(static_cast<uint64_t>(xored >> trailing), length);
+                mStoredClass = Layout::NoClass;
+                continue;
+            }
+            if (index == mStoredClass) {
+                writer.put(2, 2);
+            } else {
+                writer.put(3 | (index << 2), 5);
+                mStoredClass = index;
+            }
+            writer.putWide(static_cast<uint64_t>(xored), Layout::Bits - leading);
+        }
+    }
+};
+
+template <typename U, typename T>
+bool decodeXor(std::string_view unread, size_t& consumed, std::span<T> values) noexcept {
+    using Layout = XorLayout<U>;
+
+    auto      begin = reinterpret_cast<const uint8_t*>(unread.data());
+    BitReader reader(begin, begin + unread.size());
+    U         previous    = 0;
+    unsigned  storedClass = Layout::NoClass;
+    for (auto& value : values) {
+        uint64_t code;
+        if (!reader.get(2, code)) { return false; }
+        if (code == 0) {
+            storedClass = Layout::NoClass;
+        } else if (code == 1) {
+            uint64_t index, length, meaningful;
+            if (!reader.get(3, index) || !reader.get(Layout::LengthBits, length) || length == 0
+                || Layout::Classes[index] + length > Layout::Bits
+                || !reader.getWide(static_cast<unsigned>(length), meaningful)) {
+                return false;
+            }
+            auto trailing  = Layout::Bits - Layout::Classes[index] - static_cast<unsigned>(length);
+            previous      ^= static_cast<U>(meaningful) << trailing;
+            storedClass    = Layout::NoClass;
+        } else {
+            if (code == 3) {
+                uint64_t index;
+                if (!reader.get(3, index)) { return false; }
+                storedClass = static_cast<unsigned>(index);
+            } else if (storedClass == Layout::NoClass) {
+                return false;
+            }
+            uint64_t meaningful;
+            if (!reader.getWide(Layout::Bits - Layout::Classes[storedClass], meaningful)) { return false; }
+            previous ^= static_cast<U>(meaningful);
+        }
+        value = std::bit_cast<T>(previous);
+    }
+    consumed = static_cast<size_t>(reader.position() - begin);
+    return true;
+}
+
+template <typename U, typename T>
+void appendXor(detail::ByteSink out, std::span<const T> values) {
+    uint8_t       bytes[(ChunkSize * XorLayout<U>::MaxBits + 7) / 8 + 1];
+    BitWriter     writer(bytes);
+    XorEncoder<U> encoder;
+    out.reserve((values.size() * XorLayout<U>::MaxBits + 7) / 8);
+    for (size_t offset = 0; offset < values.size(); offset += ChunkSize) {
+        encoder.encode(values.subspan(offset, std::min(ChunkSize, values.size() - offset)), writer);
+        out.append(bytes, writer.drain());
+    }
+    writer.finish();
+    out.append(bytes, writer.drain());
+}
+
+template <typename U, typename T>
+size_t measureXor(std::span<const T> values) noexcept {
+    BitCounter counter;
+    XorEncoder<U>().encode(values, counter);
+    return counter.bytes();
+}
+
+std::pair<uint32_t, uint32_t> minMax(std::span<const uint32_t> values) noexcept {
+    uint32_t minimum = std::numeric_limits<uint32_t>::max();
+    uint32_t maximum = 0;
+    size_t   i       = 0;
+#if defined(BSTREAM_SIMD_SSE2)
+    if (values.size() >= 4) {
+        // SSE2 only compares signed lanes, so compare with the sign bit flipped
+        const __m128i bias   = _mm_set1_epi32(std::numeric_limits<int32_t>::min());
+        __m128i       lowest = _mm_set1_epi32(std::numeric_limits<int32_t>::max());
+        __m128i       most   = bias;
+        for (; i + 4 <= values.size(); i += 4) {
+            __m128i value   = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values.data() + i)), bias);
+            __m128i less    = _mm_cmplt_epi32(value, lowest);
+            __m128i greater = _mm_cmpgt_epi32(value, most);
+            lowest          = _mm_or_si128(_mm_and_si128(less, value), _mm_andnot_si128(less, lowest));
+            most            = _mm_or_si128(_mm_and_si128(greater, value), _mm_andnot_si128(greater, most));
+        }
+        alignas(16) uint32_t lanes[8];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_xor_si128(lowest, bias));
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes + 4), _mm_xor_si128(most, bias));
+        for (size_t lane = 0; lane < 4; ++lane) {
+            minimum = std::min(minimum, lanes[lane]);
+            maximum = std::max(maximum, lanes[lane + 4]);
+        }
+    }
+#elif defined(BSTREAM_SIMD_NEON)
+    if (values.size() >= 4) {
+        uint32x4_t lowest = vdupq_n_u32(std::numeric_limits<uint32_t>::max());
+        uint32x4_t most   = vdupq_n_u32(0);
+        for (; i + 4 <= values.size(); i += 4) {
+            uint32x4_t value = vld1q_u32(values.data() + i);
+            lowest           = vminq_u32(lowest, value);
+            most             = vmaxq_u32(most, value);
+        }
+        minimum = vminvq_u32(lowest);
+        maximum = vmaxvq_u32(most);
+    }
+#endif
+    for (; i < values.size(); ++i) {
+        minimum = std::min(minimum, values[i]);
+        maximum = std::max(maximum, values[i]);
+    }
+    return {minimum, maximum};
+}
+
+// Frame-of-reference bits are one contiguous stream, so every 8 values at width W fill exactly W bytes. Full groups
+// go through kernels specialized per width, where every shift is a constant and the loops unroll; the last partial
+// group uses the bit writer and reader.
+constexpr size_t ForGroupSize = 8;
+
+template <unsigned Width>
+void packForGroup(const uint32_t* values, uint32_t minimum, uint8_t* out) noexcept {
+    uint64_t words[(Width + 7) / 8]{};
+    for (size_t i = 0; i < ForGroupSize; ++i) {
+        uint64_t value = values[i] - minimum;
+        size_t   bit   = i * Width;
+        words[bit / 64] |= value << (bit % 64);
+        if (bit % 64 + Width > 64) { words[bit / 64 + 1] |= value >> (64 - bit % 64); }
+    }
+    if constexpr (std::endian::native == std::endian::big) {
+        for (auto& word : words) { word = detail::swapEndian(word); }
+    }
+    std::memcpy(out, words, Width);
+}
+
+template <unsigned Width>
+void unpackForGroup(const uint8_t* in, uint32_t minimum, uint32_t* values) noexcept {
+    uint64_t words[(Width + 7) / 8]{};
+    std::memcpy(words, in, Width);
+    if constexpr (std::endian::native == std::endian::big) {
+        for (auto& word : words) { word = detail::swapEndian(word); }
+    }
+    constexpr uint64_t Mask = (uint64_t(1) << Width) - 1;
+    for (size_t i = 0; i < ForGroupSize; ++i) {
+        size_t   bit   = i * Width;
+        uint64_t value = words[bit / 64] >> (bit % 64);
+        if (bit % 64 + Width > 64) { value |= words[bit / 64 + 1] << (64 - bit % 64); }
+        values[i] = minimum + static_cast<uint32_t>(value & Mask);
+    }
+}
+
+using ForPackKernel   = void (*)(const uint32_t*, uint32_t, uint8_t*) noexcept;
+using ForUnpackKernel = void (*)(const uint8_t*, uint32_t, uint32_t*) noexcept;
+
+template <size_t... I>
+constexpr std::array<ForPackKernel, sizeof...(I)> makeForPackKernels(std::index_sequence<I...>) noexcept {
+    return {&packForGroup<I + 1>...};
+}
+
+template <size_t... I>
+constexpr std::array<ForUnpackKernel, sizeof...(I)> makeForUnpackKernels(std::index_sequence<I...>) noexcept {
+    return {&unpackForGroup<I + 1>...};
+}
+
+constexpr auto ForPackKernels   = makeForPackKernels(std::make_index_sequence<32>());
+constexpr auto ForUnpackKernels = makeForUnpackKernels(std::make_index_sequence<32>());
+
+} // namespace
+
+namespace detail {
+
+void appendDeltaVarInts(ByteSink out, std::span<const int32_t> values) {
+    appendDerivedVarInts<uint32_t>(out, values, &deltaTransform<int32_t>);
+}
+
+void appendDeltaVarInt64s(ByteSink out, std::span<const int64_t> values) {
+    appendDerivedVarInts<uint64_t>(out, values, &deltaTransform<int64_t>);
+}
+
+void appendXorFloats(ByteSink out, std::span<const float> values) { appendXor<uint32_t>(out, values); }
+
+void appendXorDoubles(ByteSink out, std::span<const double> values) { appendXor<uint64_t>(out, values); }
+
+void appendFrameOfReference(ByteSink out, std::span<const uint32_t> values) {
+    auto [minimum, maximum] = values.empty() ? std::pair<uint32_t, uint32_t>() : minMax(values);
+    auto width              = static_cast<uint8_t>(std::bit_width(maximum - minimum));
+
+    uint8_t header[MaxVarInt64Length + 1];
+    size_t  headerLength   = encodeVarInt(minimum, header);
+    header[headerLength++] = width;
+    out.append(header, headerLength);
+    if (width == 0) { return; }
+    out.reserve((values.size() * width + 7) / 8);
+
+    // Whole groups a chunk at a time, then the last partial group; a group is at most 32 bytes wide
+    constexpr size_t ChunkGroups = ChunkSize / ForGroupSize;
+    uint8_t          packed[ChunkGroups * 32];
+    size_t           groups = values.size() / ForGroupSize;
+    auto             kernel = ForPackKernels[width - 1];
+    for (size_t first = 0; first < groups; first += ChunkGroups) {
+        size_t count = std::min(ChunkGroups, groups - first);
+        for (size_t g = 0; g < count; ++g) {
+            kernel(values.data() + (first + g) * ForGroupSize, minimum, packed + g * width);
+        }
+        out.append(packed, count * width);
+    }
+
+    BitWriter writer(packed);
+    for (size_t i = groups * ForGroupSize; i < values.size(); ++i) { writer.put(values[i] - minimum, width); }
+    writer.finish();
+    out.append(packed, writer.drain());
+}
+
+size_t measureDeltaVarInts(std::span<const int32_t> values) noexcept {
+    return measureDerivedVarInts(values, &deltaTransform<int32_t>);
+}
+
+size_t measureDeltaVarInt64s(std::span<const int64_t> values) noexcept {
+    return measureDerivedVarInts(values, &deltaTransform<int64_t>);
+}
+
+size_t measureXorFloats(std::span<const float> values) noexcept { return measureXor<uint32_t>(values); }
+
+size_t measureXorDoubles(std::span<const double> values) noexcept { return measureXor<uint64_t>(values); }
+
+size_t measureFrameOfReference(std::span<const uint32_t> values) noexcept {
+    auto [minimum, maximum] = values.empty() ? std::pair<uint32_t, uint32_t>() : minMax(values);
+    auto width              = static_cast<size_t>(std::bit_width(maximum - minimum));
+    return varIntLength(minimum) + 1 + (values.size() * width + 7) / 8;
+}
+
+} // namespace detail
+
+void BinaryStream::writeDeltaVarInts(std::span<const int32_t> values) {
+    detail::appendDeltaVarInts(detail::ByteSink(mBuffer), values);
+    mBufferView = mBuffer;
+}
+
+void BinaryStream::writeDeltaVarInt64s(std::span<const int64_t> values) {
+    detail::appendDeltaVarInt64s(detail::ByteSink(mBuffer), values);
+    mBufferView = mBuffer;
+}
+
+void BinaryStream::writeXorFloats(std::span<const float> values) {
+    detail::appendXorFloats(detail::ByteSink(mBuffer), values);
+    mBufferView = mBuffer;
+}
+
+void BinaryStream::writeXorDoubles(std::span<const double> values) {
+    detail::appendXorDoubles(detail::ByteSink(mBuffer), values);
+    mBufferView = mBuffer;
+}
+
+void BinaryStream::writeFrameOfReference(std::span<const uint32_t> values) {
+    detail::appendFrameOfReference(detail::ByteSink(mBuffer), values);
+    mBufferView = mBuffer;
+}
+
+namespace detail {
+
+bool decodeDeltaVarInts(std::string_view unread, size_t& consumed, std::span<int32_t> values) {
+    return readDerivedVarInts<uint32_t>(unread, consumed, values, &deltaRestore<int32_t>);
+}
+
+bool decodeDeltaVarInt64s(std::string_view unread, size_t& consumed, std::span<int64_t> values) {
+    return readDerivedVarInts<uint64_t>(unread, consumed, values, &deltaRestore<int64_t>);
+}
+
+bool decodeXorFloats(std::string_view unread, size_t& consumed, std::span<float> values) {
+    return decodeXor<uint32_t>(unread, consumed, values);
+}
+
+bool decodeXorDoubles(std::string_view unread, size_t& consumed, std::span<double> values) {
+    return decodeXor<uint64_t>(unread, consumed, values);
+}
+
+bool decodeFrameOfReference(std::string_view unread, size_t& consumed, std::span<uint32_t> values) {
+    auto begin  = reinterpret_cast<const uint8_t*>(unread.data());
+    auto end    = begin + unread.size();
+    auto cursor = begin;
+
+    uint32_t minimum;
+    if (!decodeVarInt(cursor, end, minimum) || cursor == end || *cursor > 32) { return false; }
+    unsigned width = *cursor++;
+    if ((values.size() * width + 7) / 8 > static_cast<size_t>(end - cursor)) { return false; }
+
+    if (width == 0) {
+        std::fill(values.begin(), values.end(), minimum);
+    } else {
+        size_t groups = values.size() / ForGroupSize;
+        auto   kernel = ForUnpackKernels[width - 1];
+        for (size_t g = 0; g < groups; ++g) { kernel(cursor + g * width, minimum, values.data() + g * ForGroupSize); }
+
+        BitReader reader(cursor + groups * width, end);
+        for (size_t i = groups * ForGroupSize; i < values.size(); ++i) {
+            uint64_t value = 0;
+            static_cast<void>(reader.get(width, value));
+            values[i] = minimum + static_cast<uint32_t>(value);
+        }
+        cursor = reader.position();
+    }
+    consumed = static_cast<size_t>(cursor - begin);
+    return true;
+}
+
+} // namespace detail
+
+bool ReadOnlyBinaryStream::getDeltaVarInts(std::span<int32_t> values) {
+    return decodeUnread([values](std::string_view unread, size_t& consumed) {
+        return detail::decodeDeltaVarInts(unread, consumed, values);
+    });
+}
+
+bool ReadOnlyBinaryStream::getDeltaVarInt64s(std::span<int64_t> values) {
+    return decodeUnread([values](std::string_view unread, size_t& consumed) {
+        return detail::decodeDeltaVarInt64s(unread, consumed, values);
+    });
+}
+
+bool ReadOnlyBinaryStream::getXorFloats(std::span<float> values) {
+    return decodeUnread([values](std::string_view unread, size_t& consumed) {
+        return detail::decodeXorFloats(unread, consumed, values);
+    });
+}
+
+bool ReadOnlyBinaryStream::getXorDoubles(std::span<double> values) {
+    return decodeUnread([values](std::string_view unread, size_t& consumed) {
+        return detail::decodeXorDoubles(unread, consumed, values);
+    });
+}
+
+bool ReadOnlyBinaryStream::getFrameOfReference(std::span<uint32_t> values) {
+    return decodeUnread([values](std::string_view unread, size_t& consumed) {
+        return detail::decodeFrameOfReference(unread, consumed, values);
+    });
+}
+
+} // namespace bstream
@@ -0,0 +1,30 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "binarystream/SharedBuffer.hpp"
+
+namespace bstream {
+
+SharedBuffer::SharedBuffer(std::string&& buffer) : mStorage(std::make_shared<const std::string>(std::move(buffer))) {}
+
+SharedBuffer::SharedBuffer(std::string_view buffer) : mStorage(std::make_shared<const std::string>(buffer)) {}
+
+std::string_view SharedBuffer::view() const noexcept {
+    return mStorage ? std::string_view(*mStorage) : std::string_view();
+}
+
+const char* SharedBuffer::data() const noexcept { return mStorage ? mStorage->data() : nullptr; }
+
+size_t SharedBuffer::size() const noexcept { return mStorage ? mStorage->size() : 0; }
+
+bool SharedBuffer::empty() const noexcept { return size() == 0; }
+
+long SharedBuffer::useCount() const noexcept { return mStorage.use_count(); }
+
+SharedBuffer::operator bool() const noexcept { return static_cast<bool>(mStorage); }
+
+} // namespace bstream
@@ -0,0 +1,116 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "binarystream/SpscRingBuffer.hpp"
+#include <bit>
+#include <cstring>
+#include <limits>
+
+namespace bstream {
+
+namespace {
+
+// Each record is a native-endian uint32_t length followed by the payload. A length of WrapMarker, or fewer than
+// HeaderSize bytes left before the end of the ring, means the next record starts at the beginning of the ring.
+constexpr size_t   HeaderSize = sizeof(uint32_t);
+constexpr uint32_t WrapMarker = std::numeric_limits<uint32_t>::max();
+
+} // namespace
+
+SpscRingBuffer::SpscRingBuffer(size_t capacity, bool bigEndian)
+: mStorage(std::make_unique_for_overwrite<char[]>(std::bit_ceil(std::max(capacity, CacheLineSize)))),
+  mCapacity(std::bit_ceil(std::max(capacity, CacheLineSize))),
+  mBigEndian(bigEndian),
+  mHead(0),
+  mCachedTail(0),
+  mReservedStart(0),
+  mHasReservation(false),
+  mTail(0),
+  mCachedHead(0),
+  mReadIndex(0),
+  mPendingRelease(0) {}
+
+size_t SpscRingBuffer::capacity() const noexcept { return mCapacity; }
+
+bool SpscRingBuffer::hasRoom(size_t head, size_t required) {
+    if (required <= mCapacity - (head - mCachedTail)) { return true; }
+    mCachedTail = mTail.load(std::memory_order_acquire);
+    return required <= mCapacity - (head - mCachedTail);
+}
+
+std::optional<SpanBinaryStream> SpscRingBuffer::tryReserve(size_t maxSize) {
+    if (maxSize > mCapacity - HeaderSize || maxSize >= WrapMarker) { return std::nullopt; }
+
+    size_t head   = mHead.load(std::memory_order_relaxed);
+    size_t offset = head & (mCapacity - 1);
+    if (mCapacity - offset < HeaderSize + maxSize) {
+        // Publish the unused tail of the ring on its own, so the consumer can skip it and hand the space back before
+        // the record has to fit at the start of the ring
+        size_t skip = mCapacity - offset;
+        if (!hasRoom(head, skip)) { return std::nullopt; }
+        if (skip >= HeaderSize) { std::memcpy(mStorage.get() + offset, &WrapMarker, HeaderSize); }
+        head += skip;
+        mHead.store(head, std::memory_order_release);
+    }
+    if (!hasRoom(head, HeaderSize + maxSize)) { return std::nullopt; }
+
+    mReservedStart  = head;
+    mHasReservation = true;
+    return SpanBinaryStream(mStorage.get() + (head & (mCapacity - 1)) + HeaderSize, maxSize, mBigEndian);
+}
+
+bool SpscRingBuffer::commit(SpanBinaryStream const& stream) {
+    if (!mHasReservation) { return false; }
+    mHasReservation = false;
+    if (stream.isOverflowed()) { return false; }
+
+    auto length = static_cast<uint32_t>(stream.size());
+    std::memcpy(mStorage.get() + (mReservedStart & (mCapacity - 1)), &length, HeaderSize);
+    mHead.store(mReservedStart + HeaderSize + stream.size(), std::memory_order_release);
+    return true;
+}
+
+bool SpscRingBuffer::tryPush(std::string_view record) {
+    auto stream = tryReserve(record.size());
+    if (!stream) { return false; }
+    stream->writeRawBytes(record);
+    return commit(*stream);
+}
+
+std::optional<ReadOnlyBinaryStream> SpscRingBuffer::tryPop() {
+    while (true) {
+        if (mReadIndex == mCachedHead) {
+            mCachedHead = mHead.load(std::memory_order_acquire);
+            if (mReadIndex == mCachedHead) { return std::nullopt; }
+        }
+
+        size_t   offset     = mReadIndex & (mCapacity - 1);
+        size_t   contiguous = mCapacity - offset;
+        uint32_t length     = WrapMarker;
+        if (contiguous >= HeaderSize) { std::memcpy(&length, mStorage.get() + offset, HeaderSize); }
+        if (length == WrapMarker) {
+            mReadIndex += contiguous;
+            mTail.store(mReadIndex, std::memory_order_release);
+            continue;
+        }
+
+        mPendingRelease = mReadIndex + HeaderSize + length;
+        return std::make_optional<ReadOnlyBinaryStream>(
+            std::string_view(mStorage.get() + offset + HeaderSize, length),
+            false,
+            mBigEndian
+        );
+    }
+}
+
+void SpscRingBuffer::release() {
+    if (mPendingRelease <= mReadIndex) { return; }
+    mReadIndex = mPendingRelease;
+    mTail.store(mReadIndex, std::memory_order_release);
+}
+
+} // namespace bstream
@@ -0,0 +1,282 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "binarystream/ReadOnlyBinaryStream.hpp"
+#include "detail/Cpu.hpp"
+#include "detail/Simd.hpp"
+#include <cstring>
+
+#if defined(BSTREAM_CPU_X86)
+#include <tmmintrin.h>
+#endif
+
+namespace bstream::detail {
+
+namespace {
+
+// Returns the length of the leading run of ASCII bytes
+size_t asciiPrefix(const uint8_t* data, size_t size) noexcept {
+    size_t pos = 0;
+#if defined(BSTREAM_SIMD_SSE2)
+    for (; pos + 16 <= size; pos += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        if (_mm_movemask_epi8(chunk) != 0) { break; }
+    }
+#endif
+    for (; pos + 8 <= size; pos += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + pos, sizeof(word));
+        if (word & 0x8080808080808080ULL) { break; }
+    }
+    while (pos < size && data[pos] < 0x80) { ++pos; }
+    return pos;
+}
+
+// Returns the length of the multi-byte sequence at data, or 0 if it is malformed (RFC 3629)
+size_t sequenceLength(const uint8_t* data, size_t size) noexcept {
+    uint8_t lead = data[0];
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        if (size < 2 || (data[1] & 0xC0) != 0x80) { return 0; }
+        return 2;
+    }
+    if (lead >= 0xE0 && lead <= 0xEF) {
+        if (size < 3) { return 0; }
+        uint8_t low  = lead == 0xE0 ? 0xA0 : 0x80;
+        uint8_t high = lead == 0xED ? 0x9F : 0xBF;
+        if (data[1] < low || data[1] > high || (data[2] & 0xC0) != 0x80) { return 0; }
+        return 3;
+    }
+    if (lead >= 0xF0 && lead <= 0xF4) {
+        if (size < 4) { return 0; }
+        uint8_t low  = lead == 0xF0 ? 0x90 : 0x80;
+        uint8_t high = lead == 0xF4 ? 0x8F : 0xBF;
+        if (data[1] < low || data[1] > high || (data[2] & 0xC0) != 0x80 || (data[3] & 0xC0) != 0x80) { return 0; }
+        return 4;
+    }
+    return 0;
+}
+
+// Only probes for an ASCII run when the current byte is ASCII, so text dominated by multi-byte characters does not
+// pay for a failed probe after every character
+bool isValidUtf8Scalar(const uint8_t* data, size_t size) noexcept {
+    size_t pos = 0;
+    while (pos < size) {
+        if (data[pos] < 0x80) {
+            pos += asciiPrefix(data + pos, size - pos);
+            continue;
+        }
+        size_t length = sequenceLength(data + pos, size - pos);
+        if (length == 0) { return false; }
+        pos += length;
+    }
+    return true;
+}
+
+#if defined(BSTREAM_CPU_X86) || defined(BSTREAM_SIMD_NEON)
+// Lookup-based validation (Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte"). Each byte is
+// classified together with its predecessor through three 16-entry tables whose AND is non-zero exactly for the
+// malformed two-byte patterns; the third and fourth bytes of longer sequences are checked against the leads two and
+// three bytes back. Blocks that are entirely ASCII only need the previous block's sequence to be complete.
+namespace lookup {
+
+constexpr uint8_t TooShort     = 1 << 0;
+constexpr uint8_t TooLong      = 1 << 1;
+constexpr uint8_t Overlong3    = 1 << 2;
+constexpr uint8_t TooLarge     = 1 << 3;
+constexpr uint8_t Surrogate    = 1 << 4;
+constexpr uint8_t Overlong2    = 1 << 5;
+constexpr uint8_t TooLarge1000 = 1 << 6;
+constexpr uint8_t Overlong4    = 1 << 6;
+constexpr uint8_t TwoConts     = 1 << 7;
+constexpr uint8_t Carry        = TooShort | TooLong | TwoConts;
+
+alignas(16) constexpr uint8_t Byte1High[16] = {
+    TooLong,
+    TooLong,
+    TooLong,
+    TooLong,
+    TooLong,
+    TooLong,
+    TooLong,
+    TooLong,
+    TwoConts,
+    TwoConts,
+    TwoConts,
+    TwoConts,
+    TooShort | Overlong2,
+    TooShort,
+    TooShort | Overlong3 | Surrogate,
+    TooShort | TooLarge | TooLarge1000 | Overlong4
+};
+
+alignas(16) constexpr uint8_t Byte1Low[16] = {
+    Carry | Overlong3 | Overlong2 | Overlong4,
+    Carry | Overlong2,
+    Carry,
+    Carry,
+    Carry | TooLarge,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000 | Surrogate,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000
+};
+
+alignas(16) constexpr uint8_t Byte2High[16] = {
+    TooShort,
+    TooShort,
+    TooShort,
+    TooShort,
+    TooShort,
+    TooShort,
+    TooShort,
+    TooShort,
+    TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge1000 | Overlong4,
+    TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge,
+    TooLong | Overlong2 | TwoConts | Surrogate | TooLarge,
+    TooLong | Overlong2 | TwoConts | Surrogate | TooLarge,
+    TooShort,
+    TooShort,
+    TooShort,
+    TooShort
+};
+
+// A lead byte in one of the last three positions still needs continuation bytes from the next block
+alignas(16) constexpr uint8_t IncompleteLimit[16] =
+    {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1};
+
+} // namespace lookup
+#endif
+
+#if defined(BSTREAM_CPU_X86)
+struct Ssse3Validator {
+    __m128i mError          = _mm_setzero_si128();
+    __m128i mPrevious       = _mm_setzero_si128();
+    __m128i mPrevIncomplete = _mm_setzero_si128();
+
+    BSTREAM_TARGET("ssse3") static __m128i high(__m128i value) noexcept {
+        return _mm_and_si128(_mm_srli_epi16(value, 4), _mm_set1_epi8(0x0F));
+    }
+
+    BSTREAM_TARGET("ssse3") static __m128i table(const uint8_t* entries) noexcept {
+        return _mm_load_si128(reinterpret_cast<const __m128i*>(entries));
+    }
+
+    BSTREAM_TARGET("ssse3") void block(__m128i input) noexcept {
+        if (_mm_movemask_epi8(input) == 0) {
+            mError    = _mm_or_si128(mError, mPrevIncomplete);
+            mPrevious = input;
+            return;
+        }
+        __m128i prev1 = _mm_alignr_epi8(input, mPrevious, 15);
+        __m128i prev2 = _mm_alignr_epi8(input, mPrevious, 14);
+        __m128i prev3 = _mm_alignr_epi8(input, mPrevious, 13);
+
+        __m128i byte1High = _mm_shuffle_epi8(table(lookup::Byte1High), high(prev1));
+        __m128i byte1Low  = _mm_shuffle_epi8(table(lookup::Byte1Low), _mm_and_si128(prev1, _mm_set1_epi8(0x0F)));
+        __m128i byte2High = _mm_shuffle_epi8(table(lookup::Byte2High), high(input));
+        __m128i special   = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+        __m128i third  = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+        __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+        __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+
+        mError          = _mm_or_si128(mError, _mm_xor_si128(must23, special));
+        mPrevIncomplete = _mm_subs_epu8(input, table(lookup::IncompleteLimit));
+        mPrevious       = input;
+    }
+
+    BSTREAM_TARGET("ssse3") bool finish() noexcept {
+        mError = _mm_or_si128(mError, mPrevIncomplete);
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(mError, _mm_setzero_si128())) == 0xFFFF;
+    }
+};
+
+BSTREAM_TARGET("ssse3") bool isValidUtf8Ssse3(const uint8_t* data, size_t size) noexcept {
+    Ssse3Validator validator;
+    size_t         pos = 0;
+    for (; pos + 16 <= size; pos += 16) {
+        validator.block(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos)));
+    }
+    if (pos < size) {
+        alignas(16) uint8_t tail[16]{};
+        std::memcpy(tail, data + pos, size - pos);
+        validator.block(_mm_load_si128(reinterpret_cast<const __m128i*>(tail)));
+    }
+    return validator.finish();
+}
+#elif defined(BSTREAM_SIMD_NEON)
+struct NeonValidator {
+    uint8x16_t mError          = vdupq_n_u8(0);
+    uint8x16_t mPrevious       = vdupq_n_u8(0);
+    uint8x16_t mPrevIncomplete = vdupq_n_u8(0);
+
+    void block(uint8x16_t input) noexcept {
+        if (vmaxvq_u8(input) < 0x80) {
+            mError    = vorrq_u8(mError, mPrevIncomplete);
+            mPrevious = input;
+            return;
+        }
+        uint8x16_t prev1 = vextq_u8(mPrevious, input, 15);
+        uint8x16_t prev2 = vextq_u8(mPrevious, input, 14);
+        uint8x16_t prev3 = vextq_u8(mPrevious, input, 13);
+
+        uint8x16_t byte1High = vqtbl1q_u8(vld1q_u8(lookup::Byte1High), vshrq_n_u8(prev1, 4));
+        uint8x16_t byte1Low  = vqtbl1q_u8(vld1q_u8(lookup::Byte1Low), vandq_u8(prev1, vdupq_n_u8(0x0F)));
+        uint8x16_t byte2High = vqtbl1q_u8(vld1q_u8(lookup::Byte2High), vshrq_n_u8(input, 4));
+        uint8x16_t special   = vandq_u8(vandq_u8(byte1High, byte1Low), byte2High);
+
+        uint8x16_t third  = vqsubq_u8(prev2, vdupq_n_u8(0xE0 - 0x80));
+        uint8x16_t fourth = vqsubq_u8(prev3, vdupq_n_u8(0xF0 - 0x80));
+        uint8x16_t must23 = vandq_u8(vorrq_u8(third, fourth), vdupq_n_u8(0x80));
+
+        mError          = vorrq_u8(mError, veorq_u8(must23, special));
+        mPrevIncomplete = vqsubq_u8(input, vld1q_u8(lookup::IncompleteLimit));
+        mPrevious       = input;
+    }
+
+    bool finish() noexcept { return vmaxvq_u8(vorrq_u8(mError, mPrevIncomplete)) == 0; }
+};
+
+bool isValidUtf8Neon(const uint8_t* data, size_t size) noexcept {
+    NeonValidator validator;
+    size_t        pos = 0;
+    for (; pos + 16 <= size; pos += 16) { validator.block(vld1q_u8(data + pos)); }
+    if (pos < size) {
+        uint8_t tail[16]{};
+        std::memcpy(tail, data + pos, size - pos);
+        validator.block(vld1q_u8(tail));
+    }
+    return validator.finish();
+}
+#endif
+
+using Utf8Kernel = bool (*)(const uint8_t*, size_t) noexcept;
+
+Utf8Kernel selectUtf8Kernel() noexcept {
+#if defined(BSTREAM_CPU_X86)
+    if (cpu::hasSsse3()) { return &isValidUtf8Ssse3; }
+#elif defined(BSTREAM_SIMD_NEON)
+    return &isValidUtf8Neon;
+#endif
+    return &isValidUtf8Scalar;
+}
+
+} // namespace
+
+bool isValidUtf8(std::string_view text) noexcept {
+    static const Utf8Kernel kernel = selectUtf8Kernel();
+    return kernel(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+}
+
+} // namespace bstream::detail
@@ -0,0 +1,290 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "binarystream/BasicBinaryWriter.hpp"
+#include "binarystream/BinaryStream.hpp"
+#include "binarystream/SizeMeasuringStream.hpp"
+#include "detail/Cpu.hpp"
+#include "detail/Simd.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(BSTREAM_CPU_X86)
+#include <tmmintrin.h>
+#endif
+
+namespace bstream {
+
+namespace {
+
+constexpr size_t ChunkSize             = 64;
+constexpr size_t MaxPrefixVarIntLength = 9;
+constexpr size_t GroupSize             = 4;
+constexpr size_t MaxGroupLength        = 1 + GroupSize * sizeof(uint32_t);
+
+uint64_t loadLittle64(const uint8_t* data) noexcept {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    if constexpr (std::endian::native == std::endian::big) { value = detail::swapEndian(value); }
+    return value;
+}
+
+// PrefixVarint: the number of trailing zero bits in the first byte plus one gives the total length. Lengths 1 to 8
+// carry 7 bits per byte after the length bits; a zero first byte is followed by the full 8-byte value.
+size_t prefixVarIntLength(uint64_t value) noexcept {
+    auto bits = static_cast<size_t>(std::bit_width(value | 1));
+    return bits > 56 ? MaxPrefixVarIntLength : (bits + 6) / 7;
+}
+
+size_t encodePrefixVarInt(uint64_t value, uint8_t* out) noexcept {
+    size_t length = prefixVarIntLength(value);
+    if (length == MaxPrefixVarIntLength) {
+        out[0] = 0;
+        for (size_t i = 0; i < 8; ++i) { out[i + 1] = static_cast<uint8_t>(value >> (8 * i)); }
+        return MaxPrefixVarIntLength;
+    }
+    uint64_t encoded = ((value << 1) | 1) << (length - 1);
+    for (size_t i = 0; i < length; ++i) { out[i] = static_cast<uint8_t>(encoded >> (8 * i)); }
+    return length;
+}
+
+bool decodePrefixVarInt(const uint8_t*& cursor, const uint8_t* end, uint64_t& value) noexcept {
+    if (cursor == end) { return false; }
+    auto length    = static_cast<size_t>(std::countr_zero(static_cast<unsigned>(*cursor) | 0x100u)) + 1;
+    auto available = static_cast<size_t>(end - cursor);
+    if (length > available) { return false; }
+
+    if (length == MaxPrefixVarIntLength) {
+        value = loadLittle64(cursor + 1);
+    } else if (available >= sizeof(uint64_t)) {
+        value = (loadLittle64(cursor) >> length) & ((uint64_t(1) << (7 * length)) - 1);
+    } else {
+        uint64_t word = 0;
+        for (size_t i = 0; i < length; ++i) { word |= static_cast<uint64_t>(cursor[i]) << (8 * i); }
+        value = word >> length;
+    }
+    cursor += length;
+    return true;
+}
+
+// Group varint: a control byte holding (length - 1) of up to four values in two-bit fields, lowest first, followed by
+// each value's significant bytes in little-endian order. A final partial group leaves its unused fields zero.
+size_t groupValueLength(uint32_t value) noexcept { return static_cast<size_t>(std::bit_width(value | 1) + 7) / 8; }
+
+size_t encodeGroup(const uint32_t* values, size_t count, uint8_t* out) noexcept {
+    uint8_t control = 0;
+    size_t  length  = 1;
+    for (size_t i = 0; i < count; ++i) {
+        auto bytes  = groupValueLength(values[i]);
+        control    |= static_cast<uint8_t>((bytes - 1) << (2 * i));
+        for (size_t j = 0; j < bytes; ++j) { out[length++] = static_cast<uint8_t>(values[i] >> (8 * j)); }
+    }
+    out[0] = control;
+    return length;
+}
+
+bool decodeGroupScalar(const uint8_t*& cursor, const uint8_t* end, uint32_t* values, size_t count) noexcept {
+    if (cursor == end) { return false; }
+    uint8_t control = *cursor;
+    size_t  length  = 1;
+    for (size_t i = 0; i < count; ++i) { length += ((control >> (2 * i)) & 3) + 1u; }
+    if (length > static_cast<size_t>(end - cursor)) { return false; }
+
+    const uint8_t* data = cursor + 1;
+    for (size_t i = 0; i < count; ++i) {
+        size_t   bytes = ((control >> (2 * i)) & 3) + 1u;
+        uint32_t value = 0;
+        for (size_t j = 0; j < bytes; ++j) { value |= static_cast<uint32_t>(data[j]) << (8 * j); }
+        values[i]  = value;
+        data      += bytes;
+    }
+    cursor += length;
+    return true;
+}
+
+#if defined(BSTREAM_CPU_X86) || defined(BSTREAM_SIMD_NEON)
+// For every control byte, the pshufb/tbl mask that moves each value's bytes into its little-endian lane (0x80 zeroes
+// a byte) and the number of data bytes in the group
+struct GroupShuffleTable {
+    uint8_t mMasks[256][16];
+    uint8_t mLengths[256];
+};
+
+constexpr GroupShuffleTable makeGroupShuffleTable() {
+    GroupShuffleTable table{};
+    for (size_t control = 0; control < 256; ++control) {
+        uint8_t offset = 0;
+        for (size_t lane = 0; lane < GroupSize; ++lane) {
+            size_t bytes = ((control >> (2 * lane)) & 3) + 1;
+            for (size_t j = 0; j < 4; ++j) {
+                table.mMasks[control][lane * 4 + j] = j < bytes ? static_cast<uint8_t>(offset + j) : 0x80;
+            }
+            offset = static_cast<uint8_t>(offset + bytes);
+        }
+        table.mLengths[control] = offset;
+    }
+    return table;
+}
+
+constexpr GroupShuffleTable GroupShuffle = makeGroupShuffleTable();
+#endif
+
+// Decodes whole groups with a 16-byte load while that many bytes follow the control byte, leaving the rest to the
+// scalar decoder; returns the number of groups decoded
+using GroupKernel = size_t (*)(const uint8_t*& cursor, const uint8_t* end, uint32_t* values, size_t groups) noexcept;
+
+size_t decodeGroupsNone(const uint8_t*&, const uint8_t*, uint32_t*, size_t) noexcept { return 0; }
+
+#if defined(BSTREAM_CPU_X86)
+BSTREAM_TARGET("ssse3")
+size_t decodeGroupsSsse3(const uint8_t*& cursor, const uint8_t* end, uint32_t* values, size_t groups) noexcept {
+    size_t decoded = 0;
+    while (decoded < groups && static_cast<size_t>(end - cursor) >= MaxGroupLength) {
+        uint8_t control = *cursor;
+        __m128i data    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor + 1));
+        __m128i mask    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(GroupShuffle.mMasks[control]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(values + decoded * GroupSize), _mm_shuffle_epi8(data, mask));
+        cursor += 1 + GroupShuffle.mLengths[control];
+        ++decoded;
+    }
+    return decoded;
+}
+#elif defined(BSTREAM_SIMD_NEON)
+size_t decodeGroupsNeon(const uint8_t*& cursor, const uint8_t* end, uint32_t* values, size_t groups) noexcept {
+    size_t decoded = 0;
+    while (decoded < groups && static_cast<size_t>(end - cursor) >= MaxGroupLength) {
+        uint8_t    control = *cursor;
+        uint8x16_t data    = vld1q_u8(cursor + 1);
+        uint8x16_t mask    = vld1q_u8(GroupShuffle.mMasks[control]);
+        vst1q_u32(values + decoded * GroupSize, vreinterpretq_u32_u8(vqtbl1q_u8(data, mask)));
+        cursor += 1 + GroupShuffle.mLengths[control];
+        ++decoded;
+    }
+    return decoded;
+}
+#endif
+
+GroupKernel selectGroupKernel() noexcept {
+#if defined(BSTREAM_CPU_X86)
+    if (detail::cpu::hasSsse3()) { return &decodeGroupsSsse3; }
+#elif defined(BSTREAM_SIMD_NEON)
+    return &decodeGroupsNeon;
+#endif
+    return &decodeGroupsNone;
+}
+
+bool decodeGroups(const uint8_t*& cursor, const uint8_t* end, std::span<uint32_t> values) noexcept {
+    static const GroupKernel kernel = selectGroupKernel();
+
+    size_t groups = kernel(cursor, end, values.data(), values.size() / GroupSize);
+    for (size_t offset = groups * GroupSize; offset < values.size(); offset += GroupSize) {
+        size_t count = std::min(GroupSize, values.size() - offset);
+        if (!decodeGroupScalar(cursor, end, values.data() + offset, count)) { return false; }
+    }
+    return true;
+}
+
+} // namespace
+
+namespace detail {
+
+void appendPrefixVarInts(ByteSink out, std::span<const uint64_t> values) {
+    uint8_t bytes[ChunkSize * MaxPrefixVarIntLength];
+    out.reserve(values.size() * MaxPrefixVarIntLength);
+    for (size_t offset = 0; offset < values.size(); offset += ChunkSize) {
+        size_t count  = std::min(ChunkSize, values.size() - offset);
+        size_t length = 0;
+        for (size_t i = 0; i < count; ++i) { length += encodePrefixVarInt(values[offset + i], bytes + length); }
+        out.append(bytes, length);
+    }
+}
+
+void appendGroupVarInts(ByteSink out, std::span<const uint32_t> values) {
+    uint8_t bytes[ChunkSize / GroupSize * MaxGroupLength];
+    out.reserve((values.size() + GroupSize - 1) / GroupSize * MaxGroupLength);
+    for (size_t offset = 0; offset < values.size(); offset += ChunkSize) {
+        size_t end    = std::min(offset + ChunkSize, values.size());
+        size_t length = 0;
+        for (size_t i = offset; i < end; i += GroupSize) {
+            length += encodeGroup(values.data() + i, std::min(GroupSize, end - i), bytes + length);
+        }
+        out.append(bytes, length);
+    }
+}
+
+size_t measurePrefixVarInts(std::span<const uint64_t> values) noexcept {
+    size_t size = 0;
+    for (uint64_t value : values) { size += prefixVarIntLength(value); }
+    return size;
+}
+
+size_t measureGroupVarInts(std::span<const uint32_t> values) noexcept {
+    size_t size = (values.size() + GroupSize - 1) / GroupSize;
+    for (uint32_t value : values) { size += groupValueLength(value); }
+    return size;
+}
+
+} // namespace detail
+
+void BinaryStream::writePrefixVarInt(uint64_t value) {
+    detail::appendPrefixVarInts(detail::ByteSink(mBuffer), std::span<const uint64_t>(&value, 1));
+    mBufferView = mBuffer;
+}
+
+void BinaryStream::writePrefixVarInts(std::span<const uint64_t> values) {
+    detail::appendPrefixVarInts(detail::ByteSink(mBuffer), values);
+    mBufferView = mBuffer;
+}
+
+void BinaryStream::writeGroupVarInts(std::span<const uint32_t> values) {
+    detail::appendGroupVarInts(detail::ByteSink(mBuffer), values);
+    mBufferView = mBuffer;
+}
+
+namespace detail {
+
+bool decodePrefixVarInts(std::string_view unread, size_t& consumed, std::span<uint64_t> values) noexcept {
+    auto begin  = reinterpret_cast<const uint8_t*>(unread.data());
+    auto end    = begin + unread.size();
+    auto cursor = begin;
+    for (auto& value : values) {
+        if (!decodePrefixVarInt(cursor, end, value)) { return false; }
+    }
+    consumed = static_cast<size_t>(cursor - begin);
+    return true;
+}
+
+bool decodeGroupVarInts(std::string_view unread, size_t& consumed, std::span<uint32_t> values) noexcept {
+    auto begin  = reinterpret_cast<const uint8_t*>(unread.data());
+    auto cursor = begin;
+    if (!decodeGroups(cursor, begin + unread.size(), values)) { return false; }
+    consumed = static_cast<size_t>(cursor - begin);
+    return true;
+}
+
+} // namespace detail
+
+uint64_t ReadOnlyBinaryStream::getPrefixVarInt() noexcept {
+    uint64_t value = 0;
+    if (!getPrefixVarInts(std::span<uint64_t>(&value, 1))) { return 0; }
+    return value;
+}
+
+bool ReadOnlyBinaryStream::getPrefixVarInts(std::span<uint64_t> values) {
+    return decodeUnread([values](std::string_view unread, size_t& consumed) {
+        return detail::decodePrefixVarInts(unread, consumed, values);
+    });
+}
+
+bool ReadOnlyBinaryStream::getGroupVarInts(std::span<uint32_t> values) {
+    return decodeUnread([values](std::string_view unread, size_t& consumed) {
+        return detail::decodeGroupVarInts(unread, consumed, values);
+    });
+}
+
+} // namespace bstream
@@ -0,0 +1,18 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace bstream::detail {
+
+// Words are in native byte order, as in PackedBitArray; bitsPerEntry must already be validated
+void packBitArray(const uint16_t* entries, size_t entryCount, uint8_t bitsPerEntry, uint8_t* words) noexcept;
+void unpackBitArray(const uint8_t* words, uint8_t bitsPerEntry, uint16_t* entries, size_t entryCount) noexcept;
+
+} // namespace bstream::detail
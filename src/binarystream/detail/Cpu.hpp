@@ -0,0 +1,52 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define BSTREAM_CPU_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// Kernels using instructions beyond the baseline are compiled per function and selected at runtime
+#if defined(BSTREAM_CPU_X86) && (defined(__GNUC__) || defined(__clang__))
+#define BSTREAM_TARGET(features) __attribute__((target(features)))
+#else
+#define BSTREAM_TARGET(features)
+#endif
+
+namespace bstream::detail::cpu {
+
+#if defined(BSTREAM_CPU_X86)
+
+#if defined(_MSC_VER) && !defined(__clang__)
+inline bool hasFeature(int leaf, int reg, int bit) noexcept {
+    int info[4];
+    __cpuidex(info, leaf, 0);
+    return (info[reg] >> bit) & 1;
+}
+
+// AVX state must also be enabled by the OS (OSXSAVE set and XCR0 saving the SSE and AVX registers), which
+// __builtin_cpu_supports checks on the other compilers
+inline bool hasAvxState() noexcept { return hasFeature(1, 2, 27) && (_xgetbv(0) & 6) == 6; }
+
+inline bool hasSsse3() noexcept { return hasFeature(1, 2, 9); }
+inline bool hasSse42() noexcept { return hasFeature(1, 2, 20); }
+inline bool hasF16c() noexcept { return hasFeature(1, 2, 29) && hasFeature(1, 2, 28) && hasAvxState(); }
+inline bool hasAvx2() noexcept { return hasFeature(7, 1, 5) && hasAvxState(); }
+#else
+inline bool hasSsse3() noexcept { return __builtin_cpu_supports("ssse3"); }
+inline bool hasSse42() noexcept { return __builtin_cpu_supports("sse4.2"); }
+inline bool hasF16c() noexcept { return __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c"); }
+inline bool hasAvx2() noexcept { return __builtin_cpu_supports("avx2"); }
+#endif
+
+#endif
+
+} // namespace bstream::detail::cpu